@@ -0,0 +1,587 @@
+#include "autograd.h"
+#include "matmul_tuner.h"
+#include "parallel.h"
+#include "cpu_dispatch.h"
+
+#include <algorithm>
+
+Tape::Tape() {
+    cursor = 0;
+}
+
+// Buffers
+
+void Tape::ensure(Tensor &t, const size_t *shape, size_t dims) {
+    bool same = t.owns_data && t.dims == dims;
+    for (size_t d = 0; same && d < dims; ++d)
+        if (t.shape[d] != shape[d]) same = false;
+    if (same) return;
+
+    size_t n = 1;
+    for (size_t d = 0; d < dims; ++d) n *= shape[d];
+
+    if (t.dims != dims) {
+        delete[] t.shape;
+        t.shape = new size_t[dims];
+        t.dims = dims;
+    }
+    for (size_t d = 0; d < dims; ++d) t.shape[d] = shape[d];
+
+    if (t.owns_data) delete[] t.data;
+    t.data = new double[n];
+    t.owns_data = true;
+}
+
+void Tape::reserve_node() {
+    if (cursor == nodes.size()) nodes.emplace_back();
+}
+
+Tape::Node &Tape::next_node(Op op) {
+    reserve_node();
+
+    Node &n = nodes[cursor++];
+    n.op = op;
+    n.a = n.b = n.c = 0;
+    n.inputs.clear();
+    n.axis = 0;
+    n.transform = nullptr;
+    n.ref = nullptr;
+    n.requires_grad = false;
+    return n;
+}
+
+const Tensor &Tape::val(size_t id) const {
+    const Node &n = nodes[id];
+    return n.ref ? *n.ref : n.value;
+}
+
+void Tape::reset() {
+    cursor = 0;
+}
+
+// Hojas
+
+Var Tape::leaf(const Tensor &t, bool requires_grad) {
+    if (t.dims == 0)
+        throw std::invalid_argument("leaf: empty tensor");
+
+    // Un mismo tensor se registra una sola vez por iteracion
+    for (size_t i = 0; i < cursor; ++i)
+        if (nodes[i].op == Op::Leaf && nodes[i].ref == &t) return {i};
+
+    Node &n = next_node(Op::Leaf);
+    n.ref = &t;
+    n.requires_grad = requires_grad;
+    return {cursor - 1};
+}
+
+Var Tape::parameter(const Tensor &t) {
+    return leaf(t, true);
+}
+
+Var Tape::input(const Tensor &t) {
+    return leaf(t, false);
+}
+
+// Operaciones
+
+Var Tape::matmul(Var a, Var b) {
+    reserve_node();
+    const Tensor &A = val(a.id);
+    const Tensor &B = val(b.id);
+
+    if (A.dims != 2 || B.dims != 2)
+        throw std::invalid_argument("both tensors must be 2D");
+    if (A.shape[1] != B.shape[0])
+        throw std::invalid_argument("incompatible shapes");
+
+    size_t N = A.shape[0], K = A.shape[1], M = B.shape[1];
+    bool rg = nodes[a.id].requires_grad || nodes[b.id].requires_grad;
+
+    Node &n = next_node(Op::Matmul);
+    n.a = a.id;
+    n.b = b.id;
+    n.requires_grad = rg;
+
+    size_t out_shape[2] = {N, M};
+    ensure(n.value, out_shape, 2);
+    std::fill(n.value.data, n.value.data + N * M, 0.0);
+    matmul_kernel(A.data, B.data, n.value.data, N, K, M,
+                  MatmulTuner::instance().config_for(N, K, M));
+
+    return {cursor - 1};
+}
+
+Var Tape::linear(Var x, Var w, Var b) {
+    reserve_node();
+    const Tensor &X = val(x.id);
+    const Tensor &W = val(w.id);
+    const Tensor &Bias = val(b.id);
+
+    if (X.dims != 2 || W.dims != 2 || Bias.dims != 2)
+        throw std::invalid_argument("linear: tensors must be 2D");
+    if (X.shape[1] != W.shape[0])
+        throw std::invalid_argument("incompatible shapes");
+    if (Bias.shape[0] != 1 || Bias.shape[1] != W.shape[1])
+        throw std::invalid_argument("linear: bias must be 1 x m");
+
+    size_t N = X.shape[0], K = X.shape[1], M = W.shape[1];
+    bool rg = nodes[x.id].requires_grad || nodes[w.id].requires_grad ||
+              nodes[b.id].requires_grad;
+
+    Node &n = next_node(Op::Linear);
+    n.a = x.id;
+    n.b = w.id;
+    n.c = b.id;
+    n.requires_grad = rg;
+
+    size_t out_shape[2] = {N, M};
+    ensure(n.value, out_shape, 2);
+    double *out = n.value.data;
+    std::fill(out, out + N * M, 0.0);
+    matmul_kernel(X.data, W.data, out, N, K, M,
+                  MatmulTuner::instance().config_for(N, K, M));
+
+    for (size_t i = 0; i < N; ++i)
+        for (size_t j = 0; j < M; ++j)
+            out[i * M + j] += Bias.data[j];
+
+    return {cursor - 1};
+}
+
+Var Tape::elementwise(Op op, Var a, Var b) {
+    reserve_node();
+    const Tensor &A = val(a.id);
+    const Tensor &B = val(b.id);
+
+    if (A.dims != B.dims)
+        throw std::invalid_argument("Dimensions must be equal \n");
+
+    bool same_shape = true;
+    for (size_t d = 0; d < A.dims; ++d)
+        if (A.shape[d] != B.shape[d]) same_shape = false;
+
+    // Forma de salida y que lado se repite por filas
+    const Tensor *out_like = &A;
+    bool a_row = false, b_row = false;
+    if (!same_shape) {
+        if (A.dims == 2 && B.shape[0] == 1 && A.shape[1] == B.shape[1]) {
+            b_row = true;
+        } else if (A.dims == 2 && A.shape[0] == 1 && A.shape[1] == B.shape[1]) {
+            a_row = true;
+            out_like = &B;
+        } else {
+            throw std::invalid_argument("elementwise: incompatible shapes");
+        }
+    }
+
+    bool rg = nodes[a.id].requires_grad || nodes[b.id].requires_grad;
+
+    Node &n = next_node(op);
+    n.a = a.id;
+    n.b = b.id;
+    n.requires_grad = rg;
+    ensure(n.value, out_like->shape, out_like->dims);
+
+    double *out = n.value.data;
+    size_t total = out_like->shape_product();
+    size_t cols = out_like->shape[out_like->dims - 1];
+
+    for (size_t i = 0; i < total; ++i) {
+        double x = A.data[a_row ? i % cols : i];
+        double y = B.data[b_row ? i % cols : i];
+        if (op == Op::Add) out[i] = x + y;
+        else if (op == Op::Sub) out[i] = x - y;
+        else out[i] = x * y;
+    }
+
+    return {cursor - 1};
+}
+
+Var Tape::add(Var a, Var b) {
+    return elementwise(Op::Add, a, b);
+}
+
+Var Tape::sub(Var a, Var b) {
+    return elementwise(Op::Sub, a, b);
+}
+
+Var Tape::mul(Var a, Var b) {
+    return elementwise(Op::Mul, a, b);
+}
+
+Var Tape::apply(Var a, const TensorTransform &transform) {
+    reserve_node();
+    const Tensor &A = val(a.id);
+    bool rg = nodes[a.id].requires_grad;
+
+    Node &n = next_node(Op::Apply);
+    n.a = a.id;
+    n.transform = &transform;
+    n.requires_grad = rg;
+    ensure(n.value, A.shape, A.dims);
+
+    // apply_n usa el kernel vectorial de la transformacion si lo tiene (ReLU)
+    transform.apply_n(A.data, n.value.data, A.shape_product());
+
+    return {cursor - 1};
+}
+
+Var Tape::view(Var a, const vector<size_t> &shape) {
+    reserve_node();
+    const Tensor &A = val(a.id);
+
+    if (shape.empty() || shape.size() > 3)
+        throw std::invalid_argument("Shape size must be between 1 and 3 \n");
+
+    size_t product = 1;
+    for (size_t d: shape) product *= d;
+    if (product != A.shape_product())
+        throw std::invalid_argument("Product of shapes must coincide");
+
+    bool rg = nodes[a.id].requires_grad;
+    double *src = A.data;
+
+    Node &n = next_node(Op::View);
+    n.a = a.id;
+    n.requires_grad = rg;
+
+    // El valor comparte datos con la entrada, como Tensor::view
+    Tensor &t = n.value;
+    if (t.owns_data) delete[] t.data;
+    if (t.dims != shape.size()) {
+        delete[] t.shape;
+        t.shape = new size_t[shape.size()];
+        t.dims = shape.size();
+    }
+    for (size_t d = 0; d < shape.size(); ++d) t.shape[d] = shape[d];
+    t.data = src;
+    t.owns_data = false;
+
+    return {cursor - 1};
+}
+
+Var Tape::concat(const vector<Var> &vars, size_t axis) {
+    if (vars.empty())
+        throw invalid_argument("empty list");
+
+    reserve_node();
+    const Tensor &base = val(vars[0].id);
+    if (axis >= base.dims)
+        throw invalid_argument("axis out of range");
+
+    size_t out_shape[3];
+    for (size_t d = 0; d < base.dims; ++d) out_shape[d] = base.shape[d];
+    out_shape[axis] = 0;
+
+    bool rg = false;
+    for (const Var &v: vars) {
+        const Tensor &t = val(v.id);
+        if (t.dims != base.dims)
+            throw invalid_argument("dims mismatch");
+        for (size_t d = 0; d < base.dims; ++d)
+            if (d != axis && t.shape[d] != base.shape[d])
+                throw invalid_argument("incompatible shapes");
+        out_shape[axis] += t.shape[axis];
+        rg = rg || nodes[v.id].requires_grad;
+    }
+
+    size_t dims = base.dims;
+    Node &n = next_node(Op::Concat);
+    for (const Var &v: vars) n.inputs.push_back(v.id);
+    n.axis = axis;
+    n.requires_grad = rg;
+    ensure(n.value, out_shape, dims);
+
+    // outer: producto de las dimensiones antes de axis; inner: despues
+    size_t outer = 1, inner = 1;
+    for (size_t d = 0; d < axis; ++d) outer *= out_shape[d];
+    for (size_t d = axis + 1; d < dims; ++d) inner *= out_shape[d];
+
+    double *out = n.value.data;
+    size_t row = out_shape[axis] * inner;
+    size_t offset = 0;
+    for (size_t id: n.inputs) {
+        const Tensor &t = val(id);
+        size_t chunk = t.shape[axis] * inner;
+        for (size_t o = 0; o < outer; ++o)
+            std::copy(t.data + o * chunk, t.data + (o + 1) * chunk, out + o * row + offset);
+        offset += chunk;
+    }
+
+    return {cursor - 1};
+}
+
+Var Tape::mse_loss(Var prediction, Var target) {
+    reserve_node();
+    const Tensor &P = val(prediction.id);
+    const Tensor &T = val(target.id);
+
+    if (P.shape_product() != T.shape_product())
+        throw std::invalid_argument("mse_loss: incompatible shapes");
+
+    bool rg = nodes[prediction.id].requires_grad || nodes[target.id].requires_grad;
+
+    Node &n = next_node(Op::MSE);
+    n.a = prediction.id;
+    n.b = target.id;
+    n.requires_grad = rg;
+
+    size_t one = 1;
+    ensure(n.value, &one, 1);
+
+    size_t total = P.shape_product();
+    double sum = 0.0;
+    for (size_t i = 0; i < total; ++i) {
+        double d = P.data[i] - T.data[i];
+        sum += d * d;
+    }
+    n.value.data[0] = sum / total;
+
+    return {cursor - 1};
+}
+
+// Consultas
+
+const Tensor &Tape::value(Var v) const {
+    if (v.id >= cursor)
+        throw std::invalid_argument("value: variable out of range");
+    return val(v.id);
+}
+
+const Tensor &Tape::grad(Var v) const {
+    if (v.id >= cursor || !nodes[v.id].requires_grad)
+        throw std::invalid_argument("grad: variable has no gradient");
+    return nodes[v.id].grad;
+}
+
+const Tensor *Tape::grad_of(const Tensor &t) const {
+    for (size_t i = 0; i < cursor; ++i)
+        if (nodes[i].op == Op::Leaf && nodes[i].ref == &t && nodes[i].requires_grad)
+            return &nodes[i].grad;
+    return nullptr;
+}
+
+// Backward
+
+void Tape::backward(Var loss) {
+    if (loss.id >= cursor)
+        throw std::invalid_argument("backward: variable out of range");
+    if (val(loss.id).shape_product() != 1)
+        throw std::invalid_argument("backward: loss must have a single element");
+
+    for (size_t i = 0; i <= loss.id; ++i) {
+        Node &n = nodes[i];
+        if (!n.requires_grad) continue;
+        const Tensor &v = val(i);
+        ensure(n.grad, v.shape, v.dims);
+        std::fill(n.grad.data, n.grad.data + v.shape_product(), 0.0);
+    }
+
+    if (!nodes[loss.id].requires_grad) return;
+    nodes[loss.id].grad.data[0] = 1.0;
+
+    for (size_t i = loss.id + 1; i-- > 0;)
+        if (nodes[i].requires_grad && nodes[i].op != Op::Leaf) backward_node(i);
+}
+
+// Gradientes de C (N x M) = A (N x K) * B (K x M) a partir de G = dC:
+// dA += G * B^T (un producto punto por elemento, en paralelo por filas de A)
+// dB += A^T * G (filas de G escaladas, en paralelo por filas k de B).
+// Con gbias tambien suma las filas de G (db de linear) en el mismo recorrido.
+// Usa el mismo numero de hilos que el matmul hacia adelante.
+static void matmul_backward(const double *a, const double *b, const double *g,
+                            double *ga, double *gb, size_t N, size_t K, size_t M,
+                            double *gbias = nullptr) {
+    const KernelTable &kt = kernels();
+    size_t threads = MatmulTuner::instance().config_for(N, K, M).threads;
+
+    if (ga) {
+        parallel_for(N, threads, [&](size_t i0, size_t i1) {
+            for (size_t i = i0; i < i1; ++i)
+                for (size_t k = 0; k < K; ++k)
+                    ga[i * K + k] += kt.dot(g + i * M, b + k * M, M);
+        });
+    }
+
+    if (gb) {
+        parallel_for(K, threads, [&](size_t k0, size_t k1) {
+            // Cada hilo recorre G una vez por filas y acumula en sus filas de dB;
+            // el que tiene k = 0 suma ademas cada fila a db mientras la lee
+            bool with_bias = gbias && k0 == 0;
+            for (size_t i = 0; i < N; ++i) {
+                if (with_bias) kt.axpy(1.0, g + i * M, gbias, M);
+                for (size_t k = k0; k < k1; ++k)
+                    kt.axpy(a[i * K + k], g + i * M, gb + k * M, M);
+            }
+        });
+    }
+
+    // Sin dB (o sin filas de B) db necesita su propio recorrido de G
+    if (gbias && (!gb || K == 0)) {
+        for (size_t i = 0; i < N; ++i) kt.axpy(1.0, g + i * M, gbias, M);
+    }
+}
+
+void Tape::backward_node(size_t id) {
+    Node &n = nodes[id];
+    const double *g = n.grad.data;
+
+    switch (n.op) {
+        case Op::Leaf:
+            break;
+
+        case Op::Matmul: {
+            const Tensor &A = val(n.a);
+            const Tensor &B = val(n.b);
+            size_t N = A.shape[0], K = A.shape[1], M = B.shape[1];
+            double *ga = nodes[n.a].requires_grad ? nodes[n.a].grad.data : nullptr;
+            double *gb = nodes[n.b].requires_grad ? nodes[n.b].grad.data : nullptr;
+
+            matmul_backward(A.data, B.data, g, ga, gb, N, K, M);
+            break;
+        }
+
+        case Op::Linear: {
+            const Tensor &X = val(n.a);
+            const Tensor &W = val(n.b);
+            size_t N = X.shape[0], K = X.shape[1], M = W.shape[1];
+            double *gx = nodes[n.a].requires_grad ? nodes[n.a].grad.data : nullptr;
+            double *gw = nodes[n.b].requires_grad ? nodes[n.b].grad.data : nullptr;
+            double *gbias = nodes[n.c].requires_grad ? nodes[n.c].grad.data : nullptr;
+
+            // db (suma por columnas de G) se calcula junto con dW
+            matmul_backward(X.data, W.data, g, gx, gw, N, K, M, gbias);
+            break;
+        }
+
+        case Op::Add:
+        case Op::Sub:
+        case Op::Mul: {
+            const Tensor &A = val(n.a);
+            const Tensor &B = val(n.b);
+            size_t total = n.value.shape_product();
+            size_t cols = n.value.shape[n.value.dims - 1];
+            bool a_row = A.shape_product() != total;
+            bool b_row = B.shape_product() != total;
+            double *ga = nodes[n.a].requires_grad ? nodes[n.a].grad.data : nullptr;
+            double *gb = nodes[n.b].requires_grad ? nodes[n.b].grad.data : nullptr;
+
+            // Los operandos repetidos por filas reducen el gradiente por columnas
+            for (size_t i = 0; i < total; ++i) {
+                size_t ia = a_row ? i % cols : i;
+                size_t ib = b_row ? i % cols : i;
+                if (n.op == Op::Add) {
+                    if (ga) ga[ia] += g[i];
+                    if (gb) gb[ib] += g[i];
+                } else if (n.op == Op::Sub) {
+                    if (ga) ga[ia] += g[i];
+                    if (gb) gb[ib] -= g[i];
+                } else {
+                    if (ga) ga[ia] += g[i] * B.data[ib];
+                    if (gb) gb[ib] += g[i] * A.data[ia];
+                }
+            }
+            break;
+        }
+
+        case Op::Apply: {
+            if (!nodes[n.a].requires_grad) break;
+            const Tensor &A = val(n.a);
+            double *ga = nodes[n.a].grad.data;
+            size_t total = A.shape_product();
+            for (size_t i = 0; i < total; ++i)
+                ga[i] += g[i] * n.transform->derivative(A.data[i]);
+            break;
+        }
+
+        case Op::View: {
+            if (!nodes[n.a].requires_grad) break;
+            double *ga = nodes[n.a].grad.data;
+            size_t total = n.value.shape_product();
+            for (size_t i = 0; i < total; ++i) ga[i] += g[i];
+            break;
+        }
+
+        case Op::Concat: {
+            size_t dims = n.value.dims;
+            size_t outer = 1, inner = 1;
+            for (size_t d = 0; d < n.axis; ++d) outer *= n.value.shape[d];
+            for (size_t d = n.axis + 1; d < dims; ++d) inner *= n.value.shape[d];
+
+            size_t row = n.value.shape[n.axis] * inner;
+            size_t offset = 0;
+            for (size_t in: n.inputs) {
+                size_t chunk = val(in).shape[n.axis] * inner;
+                if (nodes[in].requires_grad) {
+                    double *gi = nodes[in].grad.data;
+                    for (size_t o = 0; o < outer; ++o)
+                        for (size_t k = 0; k < chunk; ++k)
+                            gi[o * chunk + k] += g[o * row + offset + k];
+                }
+                offset += chunk;
+            }
+            break;
+        }
+
+        case Op::MSE: {
+            const Tensor &P = val(n.a);
+            const Tensor &T = val(n.b);
+            size_t total = P.shape_product();
+            double scale = g[0] * 2.0 / total;
+            double *gp = nodes[n.a].requires_grad ? nodes[n.a].grad.data : nullptr;
+            double *gt = nodes[n.b].requires_grad ? nodes[n.b].grad.data : nullptr;
+            for (size_t i = 0; i < total; ++i) {
+                double d = scale * (P.data[i] - T.data[i]);
+                if (gp) gp[i] += d;
+                if (gt) gt[i] -= d;
+            }
+            break;
+        }
+    }
+}
+
+// Optimizadores
+
+SGD::SGD(const vector<Tensor *> &params, double lr) : params(params), lr(lr) {}
+
+void SGD::step(const Tape &tape) {
+    for (Tensor *p: params) {
+        const Tensor *g = tape.grad_of(*p);
+        if (!g) continue;
+
+        size_t total = p->shape_product();
+        for (size_t i = 0; i < total; ++i)
+            p->data[i] -= lr * g->data[i];
+    }
+}
+
+Adam::Adam(const vector<Tensor *> &params, double lr, double beta1, double beta2, double eps)
+    : params(params), lr(lr), beta1(beta1), beta2(beta2), eps(eps), t(0) {
+    for (Tensor *p: params) {
+        m.emplace_back(p->shape_product(), 0.0);
+        v.emplace_back(p->shape_product(), 0.0);
+    }
+}
+
+void Adam::step(const Tape &tape) {
+    ++t;
+    double c1 = 1.0 - std::pow(beta1, static_cast<double>(t));
+    double c2 = 1.0 - std::pow(beta2, static_cast<double>(t));
+
+    for (size_t k = 0; k < params.size(); ++k) {
+        Tensor *p = params[k];
+        const Tensor *g = tape.grad_of(*p);
+        if (!g) continue;
+
+        size_t total = p->shape_product();
+        for (size_t i = 0; i < total; ++i) {
+            double gi = g->data[i];
+            m[k][i] = beta1 * m[k][i] + (1.0 - beta1) * gi;
+            v[k][i] = beta2 * v[k][i] + (1.0 - beta2) * gi * gi;
+            double m_hat = m[k][i] / c1;
+            double v_hat = v[k][i] / c2;
+            p->data[i] -= lr * m_hat / (std::sqrt(v_hat) + eps);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#ifndef TAREA_01_AUTOGRAD_H
+#define TAREA_01_AUTOGRAD_H
+
+#include "tensor.h"
+
+// Referencia a un valor registrado en la cinta
+struct Var {
+    size_t id;
+};
+
+// Cinta para diferenciacion automatica en modo reverso.
+//
+// Cada operacion se registra en orden; backward recorre la cinta al reves
+// acumulando gradientes. reset() no libera memoria: en la siguiente
+// iteracion cada nodo reutiliza los buffers de valor y gradiente del nodo
+// en la misma posicion si la forma coincide, por lo que un paso de
+// entrenamiento con la misma red no reserva tensores nuevos (los kernels
+// con varios hilos si crean sus std::thread en cada llamada).
+class Tape {
+private:
+    enum class Op { Leaf, Matmul, Linear, Add, Sub, Mul, Apply, View, Concat, MSE };
+
+    struct Node {
+        Op op = Op::Leaf;
+        size_t a = 0, b = 0, c = 0;
+        vector<size_t> inputs;  // Concat
+        size_t axis = 0;        // Concat
+        const TensorTransform *transform = nullptr;
+        const Tensor *ref = nullptr;  // hojas: tensor externo (sin copia)
+        bool requires_grad = false;
+        Tensor value;
+        Tensor grad;
+    };
+
+    vector<Node> nodes;
+    size_t cursor;
+
+    // Garantiza espacio para el siguiente nodo antes de tomar referencias a
+    // valores de la cinta (emplace_back podria moverlos)
+    void reserve_node();
+
+    Node &next_node(Op op);
+
+    const Tensor &val(size_t id) const;
+
+    Var leaf(const Tensor &t, bool requires_grad);
+
+    Var elementwise(Op op, Var a, Var b);
+
+    // Buffer propio con la forma dada (reutiliza el anterior si coincide)
+    static void ensure(Tensor &t, const size_t *shape, size_t dims);
+
+    void backward_node(size_t id);
+
+public:
+    Tape();
+
+    // Parametro entrenable: el gradiente se acumula en la cinta.
+    // t debe seguir vivo mientras se use la cinta.
+    Var parameter(const Tensor &t);
+
+    // Entrada constante (sin gradiente); t debe seguir vivo hasta backward
+    Var input(const Tensor &t);
+
+    Var matmul(Var a, Var b);
+
+    // x * W + b con b de 1 x m; backward calcula dx y dW en paralelo, y db junto con dW
+    Var linear(Var x, Var w, Var b);
+
+    // Mismo broadcasting que los operadores de Tensor
+    Var add(Var a, Var b);
+
+    Var sub(Var a, Var b);
+
+    Var mul(Var a, Var b);
+
+    Var apply(Var a, const TensorTransform &transform);
+
+    Var view(Var a, const vector<size_t> &shape);
+
+    Var concat(const vector<Var> &vars, size_t axis);
+
+    // Error cuadratico medio; resultado de forma {1}
+    Var mse_loss(Var prediction, Var target);
+
+    const Tensor &value(Var v) const;
+
+    const Tensor &grad(Var v) const;
+
+    // Gradiente del parametro t (nullptr si no se registro en la cinta)
+    const Tensor *grad_of(const Tensor &t) const;
+
+    // d loss / d x para todos los nodos; loss debe tener un solo elemento
+    void backward(Var loss);
+
+    // Empieza una nueva iteracion conservando los buffers
+    void reset();
+};
+
+// Descenso por gradiente: p -= lr * grad
+class SGD {
+private:
+    vector<Tensor *> params;
+    double lr;
+
+public:
+    SGD(const vector<Tensor *> &params, double lr);
+
+    void step(const Tape &tape);
+};
+
+class Adam {
+private:
+    vector<Tensor *> params;
+    vector<vector<double>> m, v;
+    double lr, beta1, beta2, eps;
+    size_t t;
+
+public:
+    Adam(const vector<Tensor *> &params, double lr = 1e-3,
+         double beta1 = 0.9, double beta2 = 0.999, double eps = 1e-8);
+
+    void step(const Tape &tape);
+};
+
+#endif //TAREA_01_AUTOGRAD_H
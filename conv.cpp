@@ -0,0 +1,222 @@
+#include "conv.h"
+#include "matmul_tuner.h"
+#include "parallel.h"
+#include "cpu_dispatch.h"
+
+#include <algorithm>
+
+struct ConvShape {
+    size_t C_in, H, W;
+    size_t C_out, kH, kW;
+    size_t stride, padding;
+    size_t H_out, W_out;
+};
+
+// Posiciones de salida [begin, end) cuya entrada o * stride + k - padding
+// cae dentro de [0, size)
+static void valid_range(size_t k, size_t size, size_t out_size, const ConvShape &s,
+                        size_t &begin, size_t &end) {
+    begin = k >= s.padding ? 0 : (s.padding - k + s.stride - 1) / s.stride;
+    end = k >= size + s.padding ? 0 : (size + s.padding - k + s.stride - 1) / s.stride;
+    end = std::min(end, out_size);
+    begin = std::min(begin, end);
+}
+
+// Columnas de una imagen: fila (ci, kh, kw) y columna (oh, ow) de la salida
+static void im2col(const double *in, double *col, const ConvShape &s) {
+    size_t P = s.H_out * s.W_out;
+
+    for (size_t ci = 0; ci < s.C_in; ++ci) {
+        for (size_t kh = 0; kh < s.kH; ++kh) {
+            size_t oh0, oh1;
+            valid_range(kh, s.H, s.H_out, s, oh0, oh1);
+
+            for (size_t kw = 0; kw < s.kW; ++kw) {
+                size_t ow0, ow1;
+                valid_range(kw, s.W, s.W_out, s, ow0, ow1);
+
+                double *row = col + ((ci * s.kH + kh) * s.kW + kw) * P;
+                std::fill(row, row + P, 0.0);
+
+                for (size_t oh = oh0; oh < oh1; ++oh) {
+                    const double *in_row = in + (ci * s.H + oh * s.stride + kh - s.padding) * s.W;
+                    double *out = row + oh * s.W_out;
+                    for (size_t ow = ow0; ow < ow1; ++ow)
+                        out[ow] = in_row[ow * s.stride + kw - s.padding];
+                }
+            }
+        }
+    }
+}
+
+// Kernel directo: cada peso suma una fila desplazada de la entrada a la
+// salida. Recorre (ci, kh, kw) en el mismo orden que la reduccion de im2col.
+static void conv_direct(const double *in, const double *weight, double *out, const ConvShape &s) {
+    const KernelTable &kt = kernels();
+
+    for (size_t co = 0; co < s.C_out; ++co) {
+        for (size_t ci = 0; ci < s.C_in; ++ci) {
+            for (size_t kh = 0; kh < s.kH; ++kh) {
+                size_t oh0, oh1;
+                valid_range(kh, s.H, s.H_out, s, oh0, oh1);
+
+                for (size_t kw = 0; kw < s.kW; ++kw) {
+                    size_t ow0, ow1;
+                    valid_range(kw, s.W, s.W_out, s, ow0, ow1);
+                    if (ow0 == ow1) continue;
+
+                    double w = weight[((co * s.C_in + ci) * s.kH + kh) * s.kW + kw];
+                    for (size_t oh = oh0; oh < oh1; ++oh) {
+                        const double *in_row = in + (ci * s.H + oh * s.stride + kh - s.padding) * s.W
+                                               + ow0 * s.stride + kw - s.padding;
+                        double *out_row = out + (co * s.H_out + oh) * s.W_out + ow0;
+
+                        if (s.stride == 1) {
+                            kt.axpy(w, in_row, out_row, ow1 - ow0);
+                        } else {
+                            for (size_t i = 0; i < ow1 - ow0; ++i)
+                                out_row[i] += w * in_row[i * s.stride];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+Tensor conv2d(const Tensor &input, const Tensor &weight, size_t in_channels,
+              size_t stride, size_t padding, ConvAlgorithm algorithm) {
+    using A = TensorAccess;
+
+    if (A::dims(input) != 3 || A::dims(weight) != 3)
+        throw std::invalid_argument("conv2d: input and weight must be 3D");
+    if (in_channels == 0 || A::shape(input, 0) % in_channels != 0 ||
+        A::shape(weight, 0) % in_channels != 0)
+        throw std::invalid_argument("conv2d: planes must be a multiple of in_channels");
+    if (stride == 0)
+        throw std::invalid_argument("conv2d: stride must be positive");
+
+    ConvShape s;
+    size_t N = A::shape(input, 0) / in_channels;
+    s.C_in = in_channels;
+    s.H = A::shape(input, 1);
+    s.W = A::shape(input, 2);
+    s.C_out = A::shape(weight, 0) / in_channels;
+    s.kH = A::shape(weight, 1);
+    s.kW = A::shape(weight, 2);
+    s.stride = stride;
+    s.padding = padding;
+
+    if (s.H + 2 * padding < s.kH || s.W + 2 * padding < s.kW)
+        throw std::invalid_argument("conv2d: kernel larger than padded input");
+
+    s.H_out = (s.H + 2 * padding - s.kH) / stride + 1;
+    s.W_out = (s.W + 2 * padding - s.kW) / stride + 1;
+
+    size_t P = s.H_out * s.W_out;
+    size_t R = s.C_in * s.kH * s.kW;
+
+    bool direct = algorithm == ConvAlgorithm::Direct ||
+                  (algorithm == ConvAlgorithm::Auto &&
+                   s.kH * s.kW <= CONV_DIRECT_MAX_TAPS && R <= CONV_DIRECT_MAX_REDUCTION);
+    // Filtro 1x1 sin stride ni relleno: la imagen ya es su matriz de columnas
+    bool pointwise = s.kH == 1 && s.kW == 1 && stride == 1 && padding == 0;
+
+    size_t threads = N * s.C_out * P * R >= CONV_PARALLEL_THRESHOLD
+                     ? std::min(N, hardware_threads()) : 1;
+
+    // Con varias imagenes en paralelo cada matmul usa un solo hilo;
+    // con una sola imagen el paralelismo queda dentro de matmul_kernel
+    MatmulConfig config = MatmulTuner::instance().config_for(s.C_out, R, P);
+    if (threads > 1) config.threads = 1;
+
+    const double *input_data = A::data(input);
+    const double *weight_data = A::data(weight);
+    vector<double> values(N * s.C_out * P, 0.0);
+
+    parallel_for(N, threads, [&](size_t n0, size_t n1) {
+        // Un buffer de columnas por hilo, reutilizado para todas sus imagenes
+        vector<double> col;
+        if (!direct && !pointwise) col.resize(R * P);
+
+        for (size_t n = n0; n < n1; ++n) {
+            const double *in = input_data + n * s.C_in * s.H * s.W;
+            double *out = values.data() + n * s.C_out * P;
+
+            if (direct) {
+                conv_direct(in, weight_data, out, s);
+            } else if (pointwise) {
+                matmul_kernel(weight_data, in, out, s.C_out, R, P, config);
+            } else {
+                im2col(in, col.data(), s);
+                matmul_kernel(weight_data, col.data(), out, s.C_out, R, P, config);
+            }
+        }
+    });
+
+    return Tensor({N * s.C_out, s.H_out, s.W_out}, values);
+}
+
+// Forma de salida del pooling; stride = 0 pasa a ser kernel
+static vector<size_t> pool_shape(const Tensor &input, size_t kernel, size_t &stride) {
+    if (TensorAccess::dims(input) != 3)
+        throw std::invalid_argument("pool2d: input must be 3D");
+    if (kernel == 0)
+        throw std::invalid_argument("pool2d: kernel must be positive");
+
+    size_t planes = TensorAccess::shape(input, 0);
+    size_t H = TensorAccess::shape(input, 1);
+    size_t W = TensorAccess::shape(input, 2);
+    if (kernel > H || kernel > W)
+        throw std::invalid_argument("pool2d: kernel larger than input");
+
+    if (stride == 0) stride = kernel;
+    return {planes, (H - kernel) / stride + 1, (W - kernel) / stride + 1};
+}
+
+// Pooling de cada plano, en paralelo por planos
+static Tensor pool2d(const Tensor &input, size_t kernel, size_t stride, bool average) {
+    vector<size_t> out_shape = pool_shape(input, kernel, stride);
+    size_t planes = out_shape[0];
+    size_t H = TensorAccess::shape(input, 1), W = TensorAccess::shape(input, 2);
+    size_t H_out = out_shape[1], W_out = out_shape[2];
+    size_t threads = planes * H_out * W_out * kernel * kernel >= CONV_PARALLEL_THRESHOLD
+                     ? hardware_threads() : 1;
+
+    const double *in = TensorAccess::data(input);
+    vector<double> values(planes * H_out * W_out);
+
+    parallel_for(planes, threads, [&](size_t p0, size_t p1) {
+        for (size_t p = p0; p < p1; ++p) {
+            const double *plane = in + p * H * W;
+            double *result = values.data() + p * H_out * W_out;
+
+            for (size_t oh = 0; oh < H_out; ++oh) {
+                for (size_t ow = 0; ow < W_out; ++ow) {
+                    const double *window = plane + oh * stride * W + ow * stride;
+                    double acc = average ? 0.0 : window[0];
+
+                    for (size_t kh = 0; kh < kernel; ++kh) {
+                        for (size_t kw = 0; kw < kernel; ++kw) {
+                            double v = window[kh * W + kw];
+                            if (average) acc += v;
+                            else if (v > acc) acc = v;
+                        }
+                    }
+
+                    result[oh * W_out + ow] = average ? acc / double(kernel * kernel) : acc;
+                }
+            }
+        }
+    });
+
+    return Tensor(out_shape, values);
+}
+
+Tensor max_pool2d(const Tensor &input, size_t kernel, size_t stride) {
+    return pool2d(input, kernel, stride, false);
+}
+
+Tensor avg_pool2d(const Tensor &input, size_t kernel, size_t stride) {
+    return pool2d(input, kernel, stride, true);
+}
@@ -0,0 +1,39 @@
+#ifndef TAREA_01_CONV_H
+#define TAREA_01_CONV_H
+
+#include "tensor.h"
+
+// Los lotes de imagenes se guardan como tensores 3D (N * C, H, W): la
+// dimension 0 recorre los planos, con los C canales de cada imagen seguidos.
+
+// Filtros con hasta este numero de posiciones (kH * kW) y una reduccion
+// C_in * kH * kW de hasta CONV_DIRECT_MAX_REDUCTION usan el kernel directo
+const size_t CONV_DIRECT_MAX_TAPS = 9;
+const size_t CONV_DIRECT_MAX_REDUCTION = 64;
+
+// A partir de este numero de multiplicaciones se reparte el lote entre hilos
+const size_t CONV_PARALLEL_THRESHOLD = 1 << 18;
+
+enum class ConvAlgorithm {
+    Auto,    // directo para filtros pequeños, im2col + GEMM en el resto
+    Im2col,  // columnas por imagen y matmul_kernel
+    Direct   // suma de filas desplazadas (axpy) sin copias
+};
+
+// Convolucion 2D (correlacion cruzada, como en las redes neuronales).
+// input:  (N * in_channels, H, W)
+// weight: (C_out * in_channels, kH, kW), los filtros de cada salida seguidos
+// salida: (N * C_out, H_out, W_out), H_out = (H + 2 * padding - kH) / stride + 1
+// Se reparte en paralelo por imagenes; cada hilo reutiliza un solo buffer de
+// columnas en lugar de construir el im2col del lote completo.
+Tensor conv2d(const Tensor &input, const Tensor &weight, size_t in_channels,
+              size_t stride = 1, size_t padding = 0,
+              ConvAlgorithm algorithm = ConvAlgorithm::Auto);
+
+// Pooling por plano sobre ventanas kernel x kernel, sin relleno.
+// stride = 0 usa stride = kernel (ventanas sin solapamiento).
+Tensor max_pool2d(const Tensor &input, size_t kernel, size_t stride = 0);
+
+Tensor avg_pool2d(const Tensor &input, size_t kernel, size_t stride = 0);
+
+#endif //TAREA_01_CONV_H
@@ -0,0 +1,340 @@
+#include "cpu_dispatch.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Variante escalar (referencia)
+
+namespace kernels_scalar {
+    double dot(const double *a, const double *b, size_t n) {
+        double acc[4] = {0.0, 0.0, 0.0, 0.0};
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            acc[0] += a[i] * b[i];
+            acc[1] += a[i + 1] * b[i + 1];
+            acc[2] += a[i + 2] * b[i + 2];
+            acc[3] += a[i + 3] * b[i + 3];
+        }
+        double result = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        for (; i < n; ++i) result += a[i] * b[i];
+        return result;
+    }
+
+    void axpy(double alpha, const double *x, double *y, size_t n) {
+        for (size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+    }
+
+    void add(const double *a, const double *b, double *out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = a[i] + b[i];
+    }
+
+    void sub(const double *a, const double *b, double *out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = a[i] - b[i];
+    }
+
+    void mul(const double *a, const double *b, double *out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = a[i] * b[i];
+    }
+
+    void scale(const double *a, double value, double *out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = a[i] * value;
+    }
+
+    void relu(const double *a, double *out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = a[i] > 0 ? a[i] : 0;
+    }
+
+    void block_4x8(const double *a, size_t lda, const double *panel, size_t K, double *c) {
+        double acc[4][8] = {};
+        for (size_t k = 0; k < K; ++k) {
+            const double *bk = panel + k * 8;
+            for (size_t r = 0; r < 4; ++r) {
+                double av = a[r * lda + k];
+                for (size_t j = 0; j < 8; ++j) acc[r][j] += av * bk[j];
+            }
+        }
+        for (size_t r = 0; r < 4; ++r)
+            for (size_t j = 0; j < 8; ++j) c[r * 8 + j] = acc[r][j];
+    }
+
+    // 4 filas a la vez para no quedar limitado por la latencia de una suma
+    void gemv(const double *a, const double *x, double *y, size_t N, size_t K) {
+        size_t i = 0;
+        for (; i + 4 <= N; i += 4) {
+            const double *r0 = a + i * K;
+            const double *r1 = r0 + K;
+            const double *r2 = r1 + K;
+            const double *r3 = r2 + K;
+            double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+            for (size_t k = 0; k < K; ++k) {
+                s0 += r0[k] * x[k];
+                s1 += r1[k] * x[k];
+                s2 += r2[k] * x[k];
+                s3 += r3[k] * x[k];
+            }
+            y[i] = s0;
+            y[i + 1] = s1;
+            y[i + 2] = s2;
+            y[i + 3] = s3;
+        }
+        for (; i < N; ++i) {
+            const double *row = a + i * K;
+            double sum = 0.0;
+            for (size_t k = 0; k < K; ++k) sum += row[k] * x[k];
+            y[i] = sum;
+        }
+    }
+}
+
+// Variantes x86 (kernels_<isa>.cpp, compiladas con sus propios flags)
+
+#ifdef TENSOR_X86_KERNELS
+#define DECLARE_KERNELS(ns)                                                   \
+    namespace ns {                                                            \
+        double dot(const double *a, const double *b, size_t n);               \
+        void axpy(double alpha, const double *x, double *y, size_t n);        \
+        void add(const double *a, const double *b, double *out, size_t n);    \
+        void sub(const double *a, const double *b, double *out, size_t n);    \
+        void mul(const double *a, const double *b, double *out, size_t n);    \
+        void scale(const double *a, double value, double *out, size_t n);     \
+        void relu(const double *a, double *out, size_t n);                    \
+        void block_4x8(const double *a, size_t lda, const double *panel,      \
+                       size_t K, double *c);                                  \
+        void gemv(const double *a, const double *x, double *y, size_t N,      \
+                  size_t K);                                                  \
+    }
+
+DECLARE_KERNELS(kernels_sse42)
+DECLARE_KERNELS(kernels_avx2)
+DECLARE_KERNELS(kernels_avx512)
+#undef DECLARE_KERNELS
+#endif
+
+#define KERNEL_TABLE(isa, ns) \
+    KernelTable{isa, ns::dot, ns::axpy, ns::add, ns::sub, ns::mul, ns::scale, ns::relu, \
+                ns::block_4x8, ns::gemv}
+
+static const KernelTable scalar_table = KERNEL_TABLE(Isa::Scalar, kernels_scalar);
+#ifdef TENSOR_X86_KERNELS
+static const KernelTable sse42_table = KERNEL_TABLE(Isa::SSE42, kernels_sse42);
+static const KernelTable avx2_table = KERNEL_TABLE(Isa::AVX2, kernels_avx2);
+static const KernelTable avx512_table = KERNEL_TABLE(Isa::AVX512, kernels_avx512);
+#endif
+#undef KERNEL_TABLE
+
+// Deteccion de la CPU
+
+#ifdef TENSOR_X86_KERNELS
+#if defined(_MSC_VER)
+static bool cpu_has(Isa isa) {
+    int info[4];
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse42 = (info[2] >> 20) & 1;
+    bool fma = (info[2] >> 12) & 1;
+    bool osxsave = (info[2] >> 27) & 1;
+
+    // El sistema operativo debe guardar los registros YMM/ZMM
+    unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    bool ymm = (xcr0 & 0x6) == 0x6;
+    bool zmm = (xcr0 & 0xE6) == 0xE6;
+
+    bool avx2 = false, avx512f = false;
+    if (max_leaf >= 7) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] >> 5) & 1;
+        avx512f = (info[1] >> 16) & 1;
+    }
+
+    switch (isa) {
+        case Isa::Scalar: return true;
+        case Isa::SSE42: return sse42;
+        case Isa::AVX2: return avx2 && fma && ymm;
+        case Isa::AVX512: return avx512f && zmm;
+    }
+    return false;
+}
+#else
+static bool cpu_has(Isa isa) {
+    __builtin_cpu_init();
+    switch (isa) {
+        case Isa::Scalar: return true;
+        case Isa::SSE42: return __builtin_cpu_supports("sse4.2");
+        case Isa::AVX2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case Isa::AVX512: return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+}
+#endif
+#endif
+
+bool isa_supported(Isa isa) {
+#ifdef TENSOR_X86_KERNELS
+    return cpu_has(isa);
+#else
+    return isa == Isa::Scalar;
+#endif
+}
+
+const char *isa_name(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return "scalar";
+        case Isa::SSE42: return "sse42";
+        case Isa::AVX2: return "avx2";
+        case Isa::AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
+const KernelTable &kernels_for(Isa isa) {
+#ifdef TENSOR_X86_KERNELS
+    switch (isa) {
+        case Isa::SSE42: return sse42_table;
+        case Isa::AVX2: return avx2_table;
+        case Isa::AVX512: return avx512_table;
+        default: break;
+    }
+#else
+    (void) isa;
+#endif
+    return scalar_table;
+}
+
+static const Isa all_isas[] = {Isa::Scalar, Isa::SSE42, Isa::AVX2, Isa::AVX512};
+
+// Mejor variante soportada, limitada por TENSOR_ISA si esta definida
+static Isa select_isa() {
+    Isa limit = Isa::AVX512;
+    if (const char *env = std::getenv("TENSOR_ISA")) {
+        for (Isa isa : all_isas)
+            if (env == std::string(isa_name(isa))) limit = isa;
+    }
+
+    Isa best = Isa::Scalar;
+    for (Isa isa : all_isas)
+        if (isa <= limit && isa_supported(isa)) best = isa;
+    return best;
+}
+
+static std::atomic<const KernelTable *> active_table{nullptr};
+
+const KernelTable &kernels() {
+    const KernelTable *table = active_table.load(std::memory_order_acquire);
+    if (!table) {
+        table = &kernels_for(select_isa());
+        active_table.store(table, std::memory_order_release);
+    }
+    return *table;
+}
+
+void set_isa(Isa isa) {
+    Isa chosen = isa_supported(isa) ? isa : Isa::Scalar;
+    active_table.store(&kernels_for(chosen), std::memory_order_release);
+}
+
+// Verificacion de las variantes
+
+bool check_kernel_variants(std::ostream &os) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> dis(-1.0, 1.0);
+
+    // Tamanos que ejercitan la parte vectorial y la cola escalar
+    const size_t sizes[] = {0, 1, 3, 7, 8, 17, 64, 1000, 4099};
+    const KernelTable &ref = scalar_table;
+    bool all_ok = true;
+
+    for (Isa isa : all_isas) {
+        if (isa == Isa::Scalar) continue;
+        if (!isa_supported(isa)) {
+            os << isa_name(isa) << ": no soportada por esta CPU" << std::endl;
+            continue;
+        }
+
+        const KernelTable &k = kernels_for(isa);
+        bool ok = true;
+        double max_dot_error = 0.0;
+
+        for (size_t n : sizes) {
+            std::vector<double> a(n), b(n), r1(n), r2(n);
+            for (size_t i = 0; i < n; ++i) {
+                a[i] = dis(gen);
+                b[i] = dis(gen);
+            }
+
+            auto same = [&]() {
+                for (size_t i = 0; i < n; ++i)
+                    if (r1[i] != r2[i]) return false;
+                return true;
+            };
+
+            ref.add(a.data(), b.data(), r1.data(), n);
+            k.add(a.data(), b.data(), r2.data(), n);
+            ok = ok && same();
+
+            ref.sub(a.data(), b.data(), r1.data(), n);
+            k.sub(a.data(), b.data(), r2.data(), n);
+            ok = ok && same();
+
+            ref.mul(a.data(), b.data(), r1.data(), n);
+            k.mul(a.data(), b.data(), r2.data(), n);
+            ok = ok && same();
+
+            ref.scale(a.data(), 0.37, r1.data(), n);
+            k.scale(a.data(), 0.37, r2.data(), n);
+            ok = ok && same();
+
+            ref.relu(a.data(), r1.data(), n);
+            k.relu(a.data(), r2.data(), n);
+            ok = ok && same();
+
+            r1 = b;
+            r2 = b;
+            ref.axpy(-1.25, a.data(), r1.data(), n);
+            k.axpy(-1.25, a.data(), r2.data(), n);
+            ok = ok && same();
+
+            // Bloque 4 x 8 con K = n sobre las primeras filas de a y b
+            if (n >= 4) {
+                size_t K = n / 4;
+                std::vector<double> panel(K * 8), c1(32), c2(32);
+                for (size_t i = 0; i < panel.size(); ++i) panel[i] = b[i % n];
+                ref.block_4x8(a.data(), K, panel.data(), K, c1.data());
+                k.block_4x8(a.data(), K, panel.data(), K, c2.data());
+                ok = ok && c1 == c2;
+            }
+
+            // gemv con K = 7 sobre n / 7 filas de a (incluye filas sueltas)
+            if (n >= 7) {
+                size_t rows = n / 7;
+                std::vector<double> y1(rows), y2(rows);
+                ref.gemv(a.data(), b.data(), y1.data(), rows, 7);
+                k.gemv(a.data(), b.data(), y2.data(), rows, 7);
+                ok = ok && y1 == y2;
+            }
+
+            // dot reordena las sumas (y puede usar FMA): error relativo
+            double d1 = ref.dot(a.data(), b.data(), n);
+            double d2 = k.dot(a.data(), b.data(), n);
+            double norm = 0.0;
+            for (size_t i = 0; i < n; ++i) norm += std::abs(a[i] * b[i]);
+            double error = norm > 0 ? std::abs(d1 - d2) / norm : std::abs(d1 - d2);
+            if (error > max_dot_error) max_dot_error = error;
+        }
+
+        ok = ok && max_dot_error < 1e-12;
+        all_ok = all_ok && ok;
+        os << isa_name(isa) << ": " << (ok ? "OK" : "FALLA")
+           << " (error relativo de dot " << max_dot_error << ")" << std::endl;
+    }
+    return all_ok;
+}
@@ -0,0 +1,45 @@
+#ifndef TAREA_01_CPU_DISPATCH_H
+#define TAREA_01_CPU_DISPATCH_H
+
+#include <cstddef>
+#include <iostream>
+
+// Variantes de los kernels compiladas en el mismo binario
+enum class Isa { Scalar, SSE42, AVX2, AVX512 };
+
+// Kernels basicos sobre arreglos de doubles. Todas las variantes dan el
+// mismo resultado que la escalar salvo dot, que reordena las sumas.
+struct KernelTable {
+    Isa isa;
+    double (*dot)(const double *a, const double *b, size_t n);
+    void (*axpy)(double alpha, const double *x, double *y, size_t n);  // y += alpha * x
+    void (*add)(const double *a, const double *b, double *out, size_t n);
+    void (*sub)(const double *a, const double *b, double *out, size_t n);
+    void (*mul)(const double *a, const double *b, double *out, size_t n);
+    void (*scale)(const double *a, double value, double *out, size_t n);
+    void (*relu)(const double *a, double *out, size_t n);
+    // c (4 x 8, contiguo) = 4 filas de a (separadas por lda) * panel (K x 8),
+    // sumando en k creciente; micro-kernel de PackedWeight
+    void (*block_4x8)(const double *a, size_t lda, const double *panel, size_t K, double *c);
+    // y (N) = a (N x K) * x (K), cada y[i] sumado en k creciente como en matmul
+    void (*gemv)(const double *a, const double *x, double *y, size_t N, size_t K);
+};
+
+// Tabla activa: se elige una vez (cpuid) la mejor variante soportada.
+// La variable de entorno TENSOR_ISA (scalar, sse42, avx2, avx512) la fuerza.
+const KernelTable &kernels();
+
+// Tabla de una variante concreta (la escalar si no esta compilada)
+const KernelTable &kernels_for(Isa isa);
+
+// Cambia la tabla activa; no llamar con operaciones en curso
+void set_isa(Isa isa);
+
+bool isa_supported(Isa isa);
+
+const char *isa_name(Isa isa);
+
+// Compara cada variante soportada con la escalar e informa en os
+bool check_kernel_variants(std::ostream &os);
+
+#endif //TAREA_01_CPU_DISPATCH_H
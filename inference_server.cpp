@@ -0,0 +1,194 @@
+#include "inference_server.h"
+
+#include <algorithm>
+#include <cmath>
+
+// LatencyHistogram
+
+LatencyHistogram::LatencyHistogram() : counts(BUCKETS, 0), total(0) {}
+
+size_t LatencyHistogram::bucket_of(double us) {
+    if (us < 1.0) return 0;
+    size_t b = static_cast<size_t>(std::log2(us) * 4.0) + 1;
+    return std::min(b, BUCKETS - 1);
+}
+
+double LatencyHistogram::bucket_upper(size_t b) {
+    return std::exp2(static_cast<double>(b) / 4.0);
+}
+
+void LatencyHistogram::add(double us) {
+    ++counts[bucket_of(us)];
+    ++total;
+}
+
+size_t LatencyHistogram::count() const {
+    return total;
+}
+
+double LatencyHistogram::percentile(double p) const {
+    if (total == 0) return 0.0;
+
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * total));
+    rank = std::max<size_t>(rank, 1);
+
+    size_t seen = 0;
+    for (size_t b = 0; b < BUCKETS; ++b) {
+        seen += counts[b];
+        if (seen >= rank) return bucket_upper(b);
+    }
+    return bucket_upper(BUCKETS - 1);
+}
+
+// InferenceStats
+
+double InferenceStats::mean_batch() const {
+    return batches == 0 ? 0.0 : static_cast<double>(requests) / batches;
+}
+
+std::ostream &operator<<(std::ostream &os, const InferenceStats &s) {
+    os << "requests: " << s.requests << ", batches: " << s.batches
+       << ", mean batch: " << s.mean_batch() << "\n";
+
+    os << "batch sizes:";
+    for (size_t n = 1; n < s.batch_sizes.size(); ++n)
+        if (s.batch_sizes[n] > 0) os << " " << n << "x" << s.batch_sizes[n];
+    os << "\n";
+
+    os << "queue delay p50/p99: " << s.queue_delay.percentile(50) << " / "
+       << s.queue_delay.percentile(99) << " us\n";
+    os << "latency     p50/p99: " << s.latency.percentile(50) << " / "
+       << s.latency.percentile(99) << " us\n";
+    return os;
+}
+
+// InferenceServer
+
+InferenceServer::InferenceServer(Model model, size_t input_size, InferenceConfig config)
+    : model(std::move(model)), input_size(input_size), config(config), stopping(false) {
+    if (input_size == 0)
+        throw std::invalid_argument("InferenceServer: input_size must be positive");
+    if (this->config.max_batch == 0)
+        throw std::invalid_argument("InferenceServer: max_batch must be positive");
+
+    current.batch_sizes.assign(this->config.max_batch + 1, 0);
+    worker = thread([this]() { worker_loop(); });
+}
+
+InferenceServer::~InferenceServer() {
+    stop();
+}
+
+void InferenceServer::stop() {
+    {
+        lock_guard<mutex> lock(m);
+        stopping = true;
+    }
+    cv.notify_all();
+
+    if (worker.joinable()) worker.join();
+}
+
+future<vector<double>> InferenceServer::submit(vector<double> input) {
+    if (input.size() != input_size)
+        throw std::invalid_argument("submit: input size must match the model");
+
+    Request r;
+    r.input = std::move(input);
+    r.enqueued = chrono::steady_clock::now();
+    future<vector<double>> f = r.result.get_future();
+
+    {
+        lock_guard<mutex> lock(m);
+        if (stopping)
+            throw std::runtime_error("submit: server is stopped");
+        queue.push_back(std::move(r));
+    }
+    cv.notify_one();
+
+    return f;
+}
+
+InferenceStats InferenceServer::stats() const {
+    lock_guard<mutex> lock(stats_mutex);
+    return current;
+}
+
+void InferenceServer::worker_loop() {
+    vector<Request> batch;
+    batch.reserve(config.max_batch);
+
+    while (true) {
+        {
+            unique_lock<mutex> lock(m);
+            cv.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (queue.empty()) return;  // stopping y sin pedidos
+
+            // Espera a llenar el lote, como mucho max_wait desde el pedido mas antiguo
+            auto deadline = queue.front().enqueued + config.max_wait;
+            cv.wait_until(lock, deadline, [this]() {
+                return stopping || queue.size() >= config.max_batch;
+            });
+
+            size_t n = std::min(config.max_batch, queue.size());
+            for (size_t i = 0; i < n; ++i) {
+                batch.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+        }
+
+        run_batch(batch);
+        batch.clear();
+    }
+}
+
+void InferenceServer::run_batch(vector<Request> &batch) {
+    auto start = chrono::steady_clock::now();
+    size_t n = batch.size();
+
+    Tensor out;
+    exception_ptr error;
+    try {
+        vector<double> values;
+        values.reserve(n * input_size);
+        for (const auto &r: batch)
+            values.insert(values.end(), r.input.begin(), r.input.end());
+
+        out = model(Tensor({n, input_size}, values));
+        if (TensorAccess::dims(out) != 2 || TensorAccess::shape(out, 0) != n)
+            throw std::runtime_error("InferenceServer: model must return one row per input");
+    } catch (...) {
+        error = current_exception();
+    }
+
+    auto done = chrono::steady_clock::now();
+
+    // Las estadisticas se registran antes de responder, para que un cliente
+    // que ya recibio su resultado las vea incluidas
+    {
+        lock_guard<mutex> lock(stats_mutex);
+        ++current.batches;
+        current.requests += n;
+        ++current.batch_sizes[n];
+        for (const auto &r: batch) {
+            current.queue_delay.add(chrono::duration<double, micro>(start - r.enqueued).count());
+            current.latency.add(chrono::duration<double, micro>(done - r.enqueued).count());
+        }
+    }
+
+    size_t answered = 0;
+    if (!error) {
+        try {
+            size_t cols = TensorAccess::shape(out, 1);
+            for (; answered < n; ++answered) {
+                const double *row = TensorAccess::data(out) + answered * cols;
+                batch[answered].result.set_value(vector<double>(row, row + cols));
+            }
+        } catch (...) {
+            error = current_exception();
+        }
+    }
+
+    for (; answered < n; ++answered)
+        batch[answered].result.set_exception(error);
+}
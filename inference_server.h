@@ -0,0 +1,106 @@
+#ifndef TAREA_01_INFERENCE_SERVER_H
+#define TAREA_01_INFERENCE_SERVER_H
+
+#include "tensor.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+// Histograma de tiempos en microsegundos con cubetas logaritmicas
+// (4 por potencia de 2, error relativo < 19%)
+class LatencyHistogram {
+private:
+    static constexpr size_t BUCKETS = 4 * 40;
+    vector<size_t> counts;
+    size_t total;
+
+    static size_t bucket_of(double us);
+
+    static double bucket_upper(size_t b);
+
+public:
+    LatencyHistogram();
+
+    void add(double us);
+
+    size_t count() const;
+
+    // Cota superior del percentil p (0 a 100)
+    double percentile(double p) const;
+};
+
+struct InferenceConfig {
+    size_t max_batch = 32;                    // filas por llamada al modelo
+    chrono::microseconds max_wait{500};       // espera maxima del primer pedido
+};
+
+struct InferenceStats {
+    vector<size_t> batch_sizes;   // batch_sizes[n]: lotes ejecutados con n filas
+    LatencyHistogram queue_delay; // desde submit hasta entrar en un lote
+    LatencyHistogram latency;     // desde submit hasta el resultado
+    size_t requests = 0;
+    size_t batches = 0;
+
+    double mean_batch() const;
+};
+
+std::ostream &operator<<(std::ostream &os, const InferenceStats &s);
+
+// Servicio de inferencia en proceso con agrupacion dinamica.
+//
+// Muchos hilos envian filas sueltas con submit(); un hilo de trabajo las
+// junta en un lote de hasta max_batch filas (o las que haya tras max_wait
+// desde el pedido mas antiguo), ejecuta el modelo una vez sobre el lote y
+// devuelve cada fila de salida por su future.
+class InferenceServer {
+public:
+    // Recibe un lote (n x input_size) y devuelve (n x salidas)
+    using Model = function<Tensor(const Tensor &)>;
+
+private:
+    struct Request {
+        vector<double> input;
+        promise<vector<double>> result;
+        chrono::steady_clock::time_point enqueued;
+    };
+
+    Model model;
+    size_t input_size;
+    InferenceConfig config;
+
+    mutex m;
+    condition_variable cv;
+    deque<Request> queue;
+    bool stopping;
+
+    mutable mutex stats_mutex;
+    InferenceStats current;
+
+    thread worker;
+
+    void worker_loop();
+
+    void run_batch(vector<Request> &batch);
+
+public:
+    InferenceServer(Model model, size_t input_size, InferenceConfig config = {});
+
+    InferenceServer(const InferenceServer &) = delete;
+    InferenceServer &operator=(const InferenceServer &) = delete;
+
+    // Atiende los pedidos pendientes y detiene el hilo de trabajo
+    ~InferenceServer();
+
+    future<vector<double>> submit(vector<double> input);
+
+    InferenceStats stats() const;
+
+    void stop();
+};
+
+#endif //TAREA_01_INFERENCE_SERVER_H
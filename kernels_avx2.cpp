@@ -0,0 +1,44 @@
+// Variante AVX2 + FMA (256 bits, 4 doubles). Se compila con -mavx2 -mfma.
+
+#include <cstddef>
+#include <immintrin.h>
+
+#define TENSOR_KERNEL_NS kernels_avx2
+
+namespace kernels_avx2 {
+    struct Vec {
+        using T = __m256d;
+        static constexpr size_t W = 4;
+
+        static T load(const double *p) { return _mm256_loadu_pd(p); }
+        static void store(double *p, T v) { _mm256_storeu_pd(p, v); }
+        static T set1(double x) { return _mm256_set1_pd(x); }
+        static T zero() { return _mm256_setzero_pd(); }
+        static T add(T a, T b) { return _mm256_add_pd(a, b); }
+        static T sub(T a, T b) { return _mm256_sub_pd(a, b); }
+        static T mul(T a, T b) { return _mm256_mul_pd(a, b); }
+        static T max(T a, T b) { return _mm256_max_pd(a, b); }
+        static T fmadd(T a, T b, T c) { return _mm256_fmadd_pd(a, b, c); }
+
+        static double hsum(T v) {
+            __m128d lo = _mm256_castpd256_pd128(v);
+            __m128d hi = _mm256_extractf128_pd(v, 1);
+            lo = _mm_add_pd(lo, hi);
+            return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+        }
+
+        // Traspone el bloque 4 x 4 de v[0..3]
+        static void transpose(T *v) {
+            T t0 = _mm256_unpacklo_pd(v[0], v[1]);
+            T t1 = _mm256_unpackhi_pd(v[0], v[1]);
+            T t2 = _mm256_unpacklo_pd(v[2], v[3]);
+            T t3 = _mm256_unpackhi_pd(v[2], v[3]);
+            v[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+            v[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+            v[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+            v[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+        }
+    };
+}
+
+#include "simd_kernels_impl.h"
@@ -0,0 +1,58 @@
+// Variante AVX-512F (512 bits, 8 doubles). Se compila con -mavx512f.
+
+#include <cstddef>
+
+// Los intrinsics AVX-512 de GCC usan _mm*_undefined_pd y generan avisos
+// -Wuninitialized falsos
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#include <immintrin.h>
+
+#define TENSOR_KERNEL_NS kernels_avx512
+
+namespace kernels_avx512 {
+    struct Vec {
+        using T = __m512d;
+        static constexpr size_t W = 8;
+
+        static T load(const double *p) { return _mm512_loadu_pd(p); }
+        static void store(double *p, T v) { _mm512_storeu_pd(p, v); }
+        static T set1(double x) { return _mm512_set1_pd(x); }
+        static T zero() { return _mm512_setzero_pd(); }
+        static T add(T a, T b) { return _mm512_add_pd(a, b); }
+        static T sub(T a, T b) { return _mm512_sub_pd(a, b); }
+        static T mul(T a, T b) { return _mm512_mul_pd(a, b); }
+        static T max(T a, T b) { return _mm512_max_pd(a, b); }
+        static T fmadd(T a, T b, T c) { return _mm512_fmadd_pd(a, b, c); }
+        static double hsum(T v) { return _mm512_reduce_add_pd(v); }
+
+        // Traspone el bloque 8 x 8 de v[0..7]: pares de filas, luego
+        // bloques de 128 bits (0x88 toma los pares, 0xDD los impares)
+        static void transpose(T *v) {
+            T t[8], u[8];
+            for (int i = 0; i < 8; i += 2) {
+                t[i] = _mm512_unpacklo_pd(v[i], v[i + 1]);
+                t[i + 1] = _mm512_unpackhi_pd(v[i], v[i + 1]);
+            }
+            for (int i = 0; i < 8; i += 4) {
+                u[i] = _mm512_shuffle_f64x2(t[i], t[i + 2], 0x88);      // columnas 0, 4
+                u[i + 1] = _mm512_shuffle_f64x2(t[i], t[i + 2], 0xDD);  // 2, 6
+                u[i + 2] = _mm512_shuffle_f64x2(t[i + 1], t[i + 3], 0x88);  // 1, 5
+                u[i + 3] = _mm512_shuffle_f64x2(t[i + 1], t[i + 3], 0xDD);  // 3, 7
+            }
+            v[0] = _mm512_shuffle_f64x2(u[0], u[4], 0x88);
+            v[4] = _mm512_shuffle_f64x2(u[0], u[4], 0xDD);
+            v[2] = _mm512_shuffle_f64x2(u[1], u[5], 0x88);
+            v[6] = _mm512_shuffle_f64x2(u[1], u[5], 0xDD);
+            v[1] = _mm512_shuffle_f64x2(u[2], u[6], 0x88);
+            v[5] = _mm512_shuffle_f64x2(u[2], u[6], 0xDD);
+            v[3] = _mm512_shuffle_f64x2(u[3], u[7], 0x88);
+            v[7] = _mm512_shuffle_f64x2(u[3], u[7], 0xDD);
+        }
+    };
+}
+
+#include "simd_kernels_impl.h"
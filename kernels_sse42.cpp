@@ -0,0 +1,37 @@
+// Variante SSE4.2 (128 bits, 2 doubles). Se compila con -msse4.2.
+
+#include <cstddef>
+#include <nmmintrin.h>
+
+#define TENSOR_KERNEL_NS kernels_sse42
+
+namespace kernels_sse42 {
+    struct Vec {
+        using T = __m128d;
+        static constexpr size_t W = 2;
+
+        static T load(const double *p) { return _mm_loadu_pd(p); }
+        static void store(double *p, T v) { _mm_storeu_pd(p, v); }
+        static T set1(double x) { return _mm_set1_pd(x); }
+        static T zero() { return _mm_setzero_pd(); }
+        static T add(T a, T b) { return _mm_add_pd(a, b); }
+        static T sub(T a, T b) { return _mm_sub_pd(a, b); }
+        static T mul(T a, T b) { return _mm_mul_pd(a, b); }
+        static T max(T a, T b) { return _mm_max_pd(a, b); }
+        static T fmadd(T a, T b, T c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+
+        static double hsum(T v) {
+            return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+        }
+
+        // Traspone el bloque 2 x 2 de v[0..1]
+        static void transpose(T *v) {
+            T t0 = _mm_unpacklo_pd(v[0], v[1]);
+            T t1 = _mm_unpackhi_pd(v[0], v[1]);
+            v[0] = t0;
+            v[1] = t1;
+        }
+    };
+}
+
+#include "simd_kernels_impl.h"
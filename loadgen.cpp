@@ -0,0 +1,72 @@
+// Generador de carga local para InferenceServer.
+//
+// Uso: loadgen [clientes] [pedidos_por_cliente] [max_batch] [max_wait_us]
+//
+// Cada cliente envia filas de 400 valores de una en una y espera su
+// resultado. Se compara la red de test_final sin agrupacion (max_batch = 1)
+// con la agrupacion dinamica.
+
+#include "inference_server.h"
+#include "packed_weight.h"
+
+#include <cstdlib>
+
+static void run(const InferenceServer::Model &model, size_t clients, size_t requests,
+                InferenceConfig config) {
+    InferenceServer server(model, 400, config);
+
+    auto t0 = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (size_t c = 0; c < clients; ++c) {
+        threads.emplace_back([&server, requests, c]() {
+            std::mt19937 gen(static_cast<unsigned>(c));
+            std::uniform_real_distribution<double> dist(0, 10);
+            vector<double> row(400);
+            for (size_t r = 0; r < requests; ++r) {
+                for (auto &x: row) x = dist(gen);
+                server.submit(row).get();
+            }
+        });
+    }
+    for (auto &t: threads) t.join();
+    auto t1 = chrono::steady_clock::now();
+
+    double seconds = chrono::duration<double>(t1 - t0).count();
+    cout << "max_batch " << config.max_batch << ", max_wait " << config.max_wait.count() << " us\n";
+    cout << "throughput: " << (clients * requests) / seconds << " req/s\n";
+    cout << server.stats() << "\n";
+}
+
+int main(int argc, char **argv) {
+    size_t clients = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    size_t requests = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+    size_t max_batch = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 32;
+    long max_wait = argc > 4 ? std::strtol(argv[4], nullptr, 10) : 500;
+
+    // Red de test_final con pesos empaquetados
+    PackedWeight C(Tensor::random({400, 100}, 0, 10));
+    Tensor E = Tensor::random({1, 100}, 0, 10);
+    PackedWeight H(Tensor::random({100, 10}, 0, 10));
+    Tensor J = Tensor::random({1, 10}, 0, 10);
+    ReLU relu;
+    Sigmoid sigmoid;
+
+    InferenceServer::Model model = [&](const Tensor &x) {
+        Tensor G = (matmul(x, C) + E).apply(relu);
+        return (matmul(G, H) + J).apply(sigmoid);
+    };
+
+    cout << clients << " clients x " << requests << " requests\n\n";
+
+    InferenceConfig single;
+    single.max_batch = 1;
+    single.max_wait = chrono::microseconds(0);
+    run(model, clients, requests, single);
+
+    InferenceConfig batched;
+    batched.max_batch = max_batch;
+    batched.max_wait = chrono::microseconds(max_wait);
+    run(model, clients, requests, batched);
+
+    return 0;
+}
@@ -1,4 +1,18 @@
 #include "tensor.h"
+#include "sparse_tensor.h"
+#include "matmul_tuner.h"
+#include "task_graph.h"
+#include "autograd.h"
+#include "static_tensor.h"
+#include "out_of_core.h"
+#include "packed_weight.h"
+#include "inference_server.h"
+#include "cpu_dispatch.h"
+#include "conv.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
 
 void test_01 () {
     auto t = Tensor::random({2,3,4}, 1,10);
@@ -144,6 +158,356 @@ void test_15 () {
     cout << B << "\n\n";
     cout << C << "\n\n";
 }
+void test_16 () {
+    // Activaciones tras ReLU: datos centrados en cero (~50% ceros) y
+    // desplazados hacia negativos (~90% ceros)
+    ReLU relu;
+    Tensor B = Tensor::random({400, 100}, -1, 1);
+    auto ms = [](auto a, auto b) { return chrono::duration<double, milli>(b - a).count(); };
+
+    auto run = [&](const Tensor &A) {
+        auto t0 = chrono::steady_clock::now();
+        Tensor dense = matmul(A, B);
+        auto t1 = chrono::steady_clock::now();
+        SparseTensor S = SparseTensor::from_dense(A);
+        Tensor sparse = matmul(S, B);
+        auto t2 = chrono::steady_clock::now();
+        Tensor autod = matmul_auto(A, B);
+        auto t3 = chrono::steady_clock::now();
+
+        Tensor diff = dense - sparse;
+        Tensor diff_auto = dense - autod;
+        bool identical = SparseTensor::density_of(diff) == 0 && SparseTensor::density_of(diff_auto) == 0;
+
+        cout << "density: " << S.density() << "\n";
+        cout << "dense:  " << ms(t0, t1) << " ms\n";
+        cout << "sparse: " << ms(t1, t2) << " ms\n";
+        cout << "auto:   " << ms(t2, t3) << " ms\n";
+        cout << "identical: " << (identical ? "yes" : "no") << "\n";
+    };
+
+    cout << "Test 16: \n";
+    run(Tensor::random({1000, 400}, -1, 1).apply(relu));
+    run(Tensor::random({1000, 400}, -9, 1).apply(relu));
+}
+
+void test_17 () {
+    // Autotuning de matmul: mide las variantes y guarda la configuracion
+    MatmulTuner &tuner = MatmulTuner::instance();
+    string path = MatmulTuner::config_path();
+
+    auto t0 = chrono::steady_clock::now();
+    tuner.tune(MatmulTuner::default_shapes());
+    auto t1 = chrono::steady_clock::now();
+    tuner.save(path);
+
+    cout << "Test 17: \n";
+    cout << "tuning: " << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+    cout << "saved to " << path << "\n";
+
+    Tensor A = Tensor::random({1000, 400}, 0, 1);
+    Tensor B = Tensor::random({400, 100}, 0, 1);
+    t0 = chrono::steady_clock::now();
+    Tensor C = matmul(A, B);
+    t1 = chrono::steady_clock::now();
+    cout << "matmul 1000x400 * 400x100: " << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+}
+
+void test_18 () {
+    // Pipeline de test_final como grafo de tareas: los pesos C, E, H, J
+    // se generan en paralelo con la primera matmul
+    ReLU relu;
+    Sigmoid sigmoid;
+
+    auto t0 = chrono::steady_clock::now();
+    TaskGraph g;
+    TensorFuture A = g.random({1000, 20, 20}, 0, 10);
+    TensorFuture C = g.random({400, 100}, 0, 10);
+    TensorFuture E = g.random({1, 100}, 0, 10);
+    TensorFuture H = g.random({100, 10}, 0, 10);
+    TensorFuture J = g.random({1, 10}, 0, 10);
+
+    TensorFuture B = g.view(A, {1000, 400});
+    TensorFuture D = g.matmul(B, C);
+    TensorFuture F = g.add(D, E);
+    TensorFuture G = g.apply(F, relu);
+    TensorFuture I = g.matmul(G, H);
+    TensorFuture K = g.add(I, J);
+    TensorFuture output = g.apply(K, sigmoid);
+
+    Tensor result = output.get();
+    auto t1 = chrono::steady_clock::now();
+
+    cout << "Test 18: \n";
+    cout << "async pipeline: " << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+    cout << result;
+}
+
+void test_19 () {
+    // Entrenamiento de la red de test_final con autograd y Adam.
+    // Los objetivos salen de una red "maestra" con pesos fijos.
+    ReLU relu;
+    Sigmoid sigmoid;
+
+    Tensor X = Tensor::random({1000, 400}, 0, 1);
+    Tensor C0 = Tensor::random({400, 100}, -0.1, 0.1);
+    Tensor E0 = Tensor::random({1, 100}, -0.1, 0.1);
+    Tensor H0 = Tensor::random({100, 10}, -1, 1);
+    Tensor J0 = Tensor::random({1, 10}, -1, 1);
+    Tensor hidden = (matmul(X, C0) + E0).apply(relu);
+    Tensor target = (matmul(hidden, H0) + J0).apply(sigmoid);
+
+    Tensor C = Tensor::random({400, 100}, -0.05, 0.05);
+    Tensor E = Tensor::zeros({1, 100});
+    Tensor H = Tensor::random({100, 10}, -0.1, 0.1);
+    Tensor J = Tensor::zeros({1, 10});
+
+    Tape tape;
+    Adam adam({&C, &E, &H, &J}, 1e-3);
+
+    auto forward = [&]() {
+        tape.reset();
+        Var x = tape.input(X);
+        Var g = tape.apply(tape.linear(x, tape.parameter(C), tape.parameter(E)), relu);
+        Var out = tape.apply(tape.linear(g, tape.parameter(H), tape.parameter(J)), sigmoid);
+        return tape.mse_loss(out, tape.input(target));
+    };
+
+    cout << "Test 19: \n";
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i) forward();
+    auto t1 = chrono::steady_clock::now();
+
+    for (int it = 0; it <= 50; ++it) {
+        Var loss = forward();
+        tape.backward(loss);
+        adam.step(tape);
+        if (it % 10 == 0) cout << "iter " << it << " loss " << tape.value(loss) << "\n";
+    }
+    auto t2 = chrono::steady_clock::now();
+
+    double fwd = chrono::duration<double, milli>(t1 - t0).count() / 10;
+    double step = chrono::duration<double, milli>(t2 - t1).count() / 51;
+    cout << "forward: " << fwd << " ms, train step: " << step << " ms (" << step / fwd << "x)\n";
+}
+
+void test_20 () {
+    // Tensores de forma fija: operaciones evaluadas al compilar
+    constexpr StaticTensor<double, 2, 3> A({1, 2, 3, 4, 5, 6});
+    constexpr StaticTensor<double, 3, 2> B({1, 2, 3, 4, 5, 6});
+    constexpr StaticTensor<double, 1, 2> bias({-1, -2});
+    constexpr auto C = matmul(A, B) + bias;
+    static_assert(C(0, 0) == 21 && C(1, 1) == 62);
+
+    cout << "Test 20: \n";
+    cout << C << "\n";
+
+    // Mezcla con Tensor dinamico: bias estatico y pesos estaticos
+    Tensor X = Tensor::random({1000, 20}, 0, 1);
+    StaticTensor<double, 20, 20> W = StaticTensor<double, 20, 20>::from_tensor(Tensor::random({20, 20}, 0, 1));
+    StaticTensor<double, 1, 20> b = StaticTensor<double, 1, 20>::ones();
+    Tensor Y = matmul(X, W) + b;
+    Tensor Y_dyn = matmul(X, W.to_tensor()) + b.to_tensor();
+    cout << "same result: " << (SparseTensor::density_of(Y - Y_dyn) == 0 ? "yes" : "no") << "\n";
+
+    // Resto de operadores con la fila estatica a cada lado
+    StaticTensor<double, 1, 20> s = StaticTensor<double, 1, 20>::from_tensor(Tensor::random({1, 20}, -1, 1));
+    Tensor sd = s.to_tensor();
+    bool same = true;
+    for (const auto &[st, dyn]: {pair{X - s, X - sd}, pair{X * s, X * sd},
+                                 pair{s + X, sd + X}, pair{s - X, sd - X}, pair{s * X, sd * X}})
+        same = same && SparseTensor::density_of(st - dyn) == 0;
+    cout << "same result (- * y fila a la izquierda): " << (same ? "yes" : "no") << "\n";
+
+    // 20 x 20 sin memoria dinamica vs Tensor
+    ReLU relu;
+    auto t0 = chrono::steady_clock::now();
+    StaticTensor<double, 20, 20> S = W;
+    for (int i = 0; i < 1000; ++i) S = (matmul(S, W) * W).apply(relu);
+    auto t1 = chrono::steady_clock::now();
+    Tensor D = W.to_tensor();
+    Tensor Wd = W.to_tensor();
+    for (int i = 0; i < 1000; ++i) D = (matmul(D, Wd) * Wd).apply(relu);
+    auto t2 = chrono::steady_clock::now();
+
+    cout << "static:  " << chrono::duration<double, milli>(t1 - t0).count() << " ms\n";
+    cout << "dynamic: " << chrono::duration<double, milli>(t2 - t1).count() << " ms\n";
+}
+
+void test_21 () {
+    // Lote de tamaño 1: matmul se desvia a gevm / gemv.
+    // Como referencia se duplica el vector para pasar por el kernel general.
+    Tensor x = Tensor::random({1, 4000}, -1, 1);
+    Tensor W = Tensor::random({4000, 1000}, -1, 1);
+    Tensor A = Tensor::random({1000, 4000}, -1, 1);
+    Tensor v = Tensor::random({4000, 1}, -1, 1);
+
+    auto t0 = chrono::steady_clock::now();
+    Tensor y1 = matmul(x, W);
+    auto t1 = chrono::steady_clock::now();
+    Tensor y2 = matmul(A, v);
+    auto t2 = chrono::steady_clock::now();
+    Tensor r1 = matmul(Tensor::concat({x, x}, 0), W);
+    auto t3 = chrono::steady_clock::now();
+    Tensor r2 = matmul(A, Tensor::concat({v, v}, 1));
+    auto t4 = chrono::steady_clock::now();
+
+    Tensor e1 = Tensor::concat({y1, y1}, 0) - r1;
+    Tensor e2 = Tensor::concat({y2, y2}, 1) - r2;
+    Tensor f1 = e1.view({e1.shape_product()});
+    Tensor f2 = e2.view({e2.shape_product()});
+
+    auto ms = [](auto a, auto b) { return chrono::duration<double, milli>(b - a).count(); };
+    cout << "Test 21: \n";
+    cout << "gevm (1x4000 * 4000x1000): " << ms(t0, t1) << " ms (general, 2 filas: " << ms(t2, t3) << " ms)\n";
+    cout << "gemv (1000x4000 * 4000x1): " << ms(t1, t2) << " ms (general, 2 columnas: " << ms(t3, t4) << " ms)\n";
+    cout << "squared error: " << dot(f1, f1) << " " << dot(f2, f2) << "\n";
+}
+
+void test_22 () {
+    // matmul con A en disco, procesada por paneles de 128 filas
+    Tensor A = Tensor::random({1000, 20, 20}, 0, 10);
+    Tensor B = A.view({1000, 400});
+    Tensor C = Tensor::random({400, 100}, 0, 10);
+
+    string dir = filesystem::temp_directory_path().string();
+    string a_path = dir + "/tensor_ooc_a.bin";
+    string c_path = dir + "/tensor_ooc_c.bin";
+    save_raw(B, a_path);
+
+    auto t0 = chrono::steady_clock::now();
+    Tensor D = matmul(B, C);
+    auto t1 = chrono::steady_clock::now();
+    matmul_out_of_core(a_path, 1000, 400, C, c_path, 128);
+    auto t2 = chrono::steady_clock::now();
+
+    Tensor D_ooc = load_raw(c_path, {1000, 100});
+    Tensor diff = D - D_ooc;
+    std::remove(a_path.c_str());
+    std::remove(c_path.c_str());
+
+    auto ms = [](auto a, auto b) { return chrono::duration<double, milli>(b - a).count(); };
+    cout << "Test 22: \n";
+    cout << "in-memory:   " << ms(t0, t1) << " ms\n";
+    cout << "out-of-core: " << ms(t1, t2) << " ms\n";
+    cout << "identical: " << (SparseTensor::density_of(diff) == 0 ? "yes" : "no") << "\n";
+}
+
+void test_23 () {
+    // Inferencia con lotes pequeños: los pesos C y H se empaquetan una vez
+    Tensor C = Tensor::random({400, 100}, 0, 10);
+    Tensor H = Tensor::random({100, 10}, 0, 10);
+    PackedWeight Cp(C);
+    PackedWeight Hp(H);
+    Tensor X = Tensor::random({8, 400}, 0, 10);
+
+    const int calls = 2000;
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) matmul(matmul(X, C), H);
+    auto t1 = chrono::steady_clock::now();
+    for (int i = 0; i < calls; ++i) matmul(matmul(X, Cp), Hp);
+    auto t2 = chrono::steady_clock::now();
+
+    Tensor diff = matmul(matmul(X, C), H) - matmul(matmul(X, Cp), Hp);
+
+    auto us = [](auto a, auto b) { return chrono::duration<double, micro>(b - a).count() / calls; };
+    cout << "Test 23: \n";
+    cout << "matmul (8x400 * 400x100 * 100x10): " << us(t0, t1) << " us/call\n";
+    cout << "packed:                            " << us(t1, t2) << " us/call\n";
+    cout << "identical: " << (SparseTensor::density_of(diff) == 0 ? "yes" : "no") << "\n";
+}
+
+void test_24 () {
+    // Servidor con agrupacion dinamica: 8 hilos envian filas sueltas
+    PackedWeight C(Tensor::random({400, 100}, 0, 10));
+    Tensor E = Tensor::random({1, 100}, 0, 10);
+    PackedWeight H(Tensor::random({100, 10}, 0, 10));
+    Tensor J = Tensor::random({1, 10}, 0, 10);
+    ReLU relu;
+    Sigmoid sigmoid;
+
+    InferenceConfig config;
+    config.max_batch = 8;
+    InferenceServer server([&](const Tensor &x) {
+        Tensor G = (matmul(x, C) + E).apply(relu);
+        return (matmul(G, H) + J).apply(sigmoid);
+    }, 400, config);
+
+    vector<thread> clients;
+    for (int c = 0; c < 8; ++c) {
+        clients.emplace_back([&server]() {
+            for (int r = 0; r < 50; ++r)
+                server.submit(vector<double>(400, 1.0)).get();
+        });
+    }
+    for (auto &t: clients) t.join();
+
+    cout << "Test 24: \n";
+    cout << server.stats();
+}
+
+void test_25 () {
+    // Despacho por CPU: variante elegida, comparacion con la escalar
+    // y tiempo de la misma matmul con cada variante soportada
+    cout << "Test 25: \n";
+    Isa selected = kernels().isa;
+    cout << "variante activa: " << isa_name(selected) << "\n";
+    check_kernel_variants(cout);
+
+    Tensor A = Tensor::random({500, 400}, -1, 1);
+    Tensor B = Tensor::random({400, 300}, -1, 1);
+
+    for (Isa isa: {Isa::Scalar, Isa::SSE42, Isa::AVX2, Isa::AVX512}) {
+        if (!isa_supported(isa)) continue;
+        set_isa(isa);
+
+        auto t0 = chrono::steady_clock::now();
+        Tensor C = matmul(A, B).apply(ReLU());
+        auto t1 = chrono::steady_clock::now();
+
+        cout << isa_name(isa) << ": " << chrono::duration<double, milli>(t1 - t0).count()
+             << " ms, suma de cuadrados " << dot(C.view({C.shape_product()}), C.view({C.shape_product()})) << "\n";
+    }
+    set_isa(selected);
+}
+
+void test_26 () {
+    // Convolucion y pooling sobre las imagenes 20x20 de test_final
+    Tensor A = Tensor::random({1000, 20, 20}, 0, 10);
+    Tensor W = Tensor::random({8, 3, 3}, -1, 1);   // 1 canal de entrada, 8 de salida
+
+    auto t0 = chrono::steady_clock::now();
+    Tensor direct = conv2d(A, W, 1, 1, 1, ConvAlgorithm::Direct);
+    auto t1 = chrono::steady_clock::now();
+    Tensor lowered = conv2d(A, W, 1, 1, 1, ConvAlgorithm::Im2col);
+    auto t2 = chrono::steady_clock::now();
+
+    // 8 canales -> 16 con filtros 5x5 y stride 2: pasa por im2col + GEMM
+    Tensor W2 = Tensor::random({16 * 8, 5, 5}, -1, 1);
+    Tensor deep = conv2d(direct, W2, 8, 2, 2);
+    auto t3 = chrono::steady_clock::now();
+
+    Tensor pooled = max_pool2d(direct.apply(ReLU()), 2);
+    Tensor averaged = avg_pool2d(deep, 2);
+
+    Tensor e = direct - lowered;
+    Tensor f = e.view({e.shape_product()});
+
+    auto ms = [](auto a, auto b) { return chrono::duration<double, milli>(b - a).count(); };
+    cout << "Test 26: \n";
+    cout << "conv 3x3 directo: " << ms(t0, t1) << " ms, im2col: " << ms(t1, t2) << " ms\n";
+    cout << "squared error: " << dot(f, f) << "\n";
+    cout << "conv 5x5 stride 2 (8 -> 16 canales): " << ms(t2, t3) << " ms\n";
+    cout << "elementos: conv " << direct.shape_product() << " -> max_pool " << pooled.shape_product()
+         << ", conv 5x5 " << deep.shape_product() << " -> avg_pool " << averaged.shape_product() << "\n";
+
+    // Caso pequeño: filtro de unos 2x2 con stride 2 suma cada ventana
+    Tensor range = Tensor::arange(0, 16);
+    Tensor B = range.view({1, 4, 4});
+    Tensor ones = Tensor::ones({1, 2, 2});
+    cout << conv2d(B, ones, 1, 2) << max_pool2d(B, 2) << avg_pool2d(B, 2);
+}
+
 void test_final () {
     // 1. Crear un tensor de entrada de dimensiones 1000 × 20 ×20.
     Tensor A = Tensor::random({1000,20,20}, 0,10);
@@ -195,6 +559,17 @@ int main() {
     // test_13();
     // test_14();
     // test_15();
+    // test_16();
+    // test_17();
+    // test_18();
+    // test_19();
+    // test_20();
+    // test_21();
+    // test_22();
+    // test_23();
+    // test_24();
+    // test_25();
+    // test_26();
     test_final();
     return 0;
 }
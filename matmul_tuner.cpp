@@ -0,0 +1,294 @@
+#include "matmul_tuner.h"
+#include "parallel.h"
+#include "cpu_dispatch.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+
+// Kernels (filas [r0, r1) de c)
+
+static void kernel_naive(const double *a, const double *b, double *c,
+                         size_t r0, size_t r1, size_t K, size_t M) {
+    for (size_t i = r0; i < r1; ++i) {
+        for (size_t j = 0; j < M; ++j) {
+            double sum = 0.0;
+            for (size_t k = 0; k < K; ++k)
+                sum += a[i * K + k] * b[k * M + j];
+            c[i * M + j] = sum;
+        }
+    }
+}
+
+static void kernel_row_axpy(const double *a, const double *b, double *c,
+                            size_t r0, size_t r1, size_t K, size_t M) {
+    const KernelTable &kt = kernels();
+    for (size_t i = r0; i < r1; ++i) {
+        double *out = c + i * M;
+        for (size_t k = 0; k < K; ++k)
+            kt.axpy(a[i * K + k], b + k * M, out, M);
+    }
+}
+
+static void kernel_blocked(const double *a, const double *b, double *c,
+                           size_t r0, size_t r1, size_t K, size_t M,
+                           const MatmulConfig &cfg) {
+    size_t bi = std::max<size_t>(cfg.block_i, 1);
+    size_t bk = std::max<size_t>(cfg.block_k, 1);
+    size_t bj = std::max<size_t>(cfg.block_j, 1);
+    const KernelTable &kt = kernels();
+
+    for (size_t ii = r0; ii < r1; ii += bi) {
+        size_t i_end = std::min(r1, ii + bi);
+        for (size_t kk = 0; kk < K; kk += bk) {
+            size_t k_end = std::min(K, kk + bk);
+            for (size_t jj = 0; jj < M; jj += bj) {
+                size_t j_end = std::min(M, jj + bj);
+                for (size_t i = ii; i < i_end; ++i) {
+                    double *out = c + i * M;
+                    for (size_t k = kk; k < k_end; ++k)
+                        kt.axpy(a[i * K + k], b + k * M + jj, out + jj, j_end - jj);
+                }
+            }
+        }
+    }
+}
+
+ShapeClass classify_shape(size_t N, size_t K, size_t M) {
+    if (N <= 32) return ShapeClass::SmallBatch;
+    if (M <= 16 || K <= 16) return ShapeClass::TallSkinny;
+    return ShapeClass::Square;
+}
+
+void matmul_kernel(const double *a, const double *b, double *c,
+                   size_t N, size_t K, size_t M, const MatmulConfig &config) {
+    size_t threads = std::max<size_t>(config.threads, 1);
+
+    parallel_for(N, threads, [&](size_t r0, size_t r1) {
+        switch (config.kernel) {
+            case MatmulKernel::Naive:
+                kernel_naive(a, b, c, r0, r1, K, M);
+                break;
+            case MatmulKernel::RowAxpy:
+                kernel_row_axpy(a, b, c, r0, r1, K, M);
+                break;
+            case MatmulKernel::Blocked:
+                kernel_blocked(a, b, c, r0, r1, K, M, config);
+                break;
+        }
+    });
+}
+
+// Serializacion
+
+static const char *class_name(ShapeClass s) {
+    switch (s) {
+        case ShapeClass::SmallBatch: return "small_batch";
+        case ShapeClass::TallSkinny: return "tall_skinny";
+        case ShapeClass::Square: return "square";
+    }
+    return "";
+}
+
+static const char *kernel_name(MatmulKernel k) {
+    switch (k) {
+        case MatmulKernel::Naive: return "naive";
+        case MatmulKernel::RowAxpy: return "row_axpy";
+        case MatmulKernel::Blocked: return "blocked";
+    }
+    return "";
+}
+
+static bool parse_class(const string &s, ShapeClass &out) {
+    for (ShapeClass c: {ShapeClass::SmallBatch, ShapeClass::TallSkinny, ShapeClass::Square})
+        if (s == class_name(c)) { out = c; return true; }
+    return false;
+}
+
+static bool parse_kernel(const string &s, MatmulKernel &out) {
+    for (MatmulKernel k: {MatmulKernel::Naive, MatmulKernel::RowAxpy, MatmulKernel::Blocked})
+        if (s == kernel_name(k)) { out = k; return true; }
+    return false;
+}
+
+// MatmulTuner
+
+MatmulTuner &MatmulTuner::instance() {
+    static MatmulTuner tuner;
+    static bool loaded = tuner.load(config_path());
+    (void) loaded;
+    return tuner;
+}
+
+string MatmulTuner::config_path() {
+    const char *env = std::getenv("TENSOR_TUNE_FILE");
+    return env ? string(env) : string(MATMUL_TUNE_FILE);
+}
+
+MatmulConfig MatmulTuner::config_for(size_t N, size_t K, size_t M) const {
+    MatmulConfig cfg;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = tuned.find(classify_shape(N, K, M));
+        if (it == tuned.end()) return heuristic(N, K, M);
+        cfg = it->second;
+    }
+
+    // Con pocas operaciones no compensa lanzar hilos
+    if (N * K * M < (1u << 16)) cfg.threads = 1;
+    return cfg;
+}
+
+MatmulConfig MatmulTuner::heuristic(size_t N, size_t K, size_t M) {
+    MatmulConfig cfg;
+    size_t work = N * K * M;
+
+    switch (classify_shape(N, K, M)) {
+        case ShapeClass::SmallBatch:
+            cfg.kernel = MatmulKernel::RowAxpy;
+            break;
+        case ShapeClass::TallSkinny:
+            cfg.kernel = MatmulKernel::RowAxpy;
+            break;
+        case ShapeClass::Square:
+            cfg.kernel = MatmulKernel::Blocked;
+            cfg.block_i = 64;
+            cfg.block_k = 128;
+            cfg.block_j = 128;
+            break;
+    }
+
+    if (work >= (1u << 22) && N >= 64) cfg.threads = hardware_threads();
+    return cfg;
+}
+
+vector<array<size_t, 3>> MatmulTuner::default_shapes() {
+    return {
+        {1000, 400, 100},  // test_final, primera capa
+        {1000, 100, 10},   // test_final, segunda capa
+        {256, 256, 256},
+        {8, 400, 100},     // lote pequeño
+    };
+}
+
+void MatmulTuner::tune(const vector<array<size_t, 3>> &shapes, size_t repetitions) {
+    vector<MatmulConfig> candidates;
+
+    vector<size_t> thread_options = {1};
+    if (hardware_threads() > 1) {
+        thread_options.push_back(hardware_threads() / 2 > 1 ? hardware_threads() / 2 : 2);
+        thread_options.push_back(hardware_threads());
+    }
+
+    const array<size_t, 3> blocks[] = {
+        {32, 64, 64}, {64, 128, 128}, {64, 256, 64}, {128, 128, 256}
+    };
+
+    for (size_t t: thread_options) {
+        MatmulConfig cfg;
+        cfg.threads = t;
+        cfg.kernel = MatmulKernel::Naive;
+        candidates.push_back(cfg);
+        cfg.kernel = MatmulKernel::RowAxpy;
+        candidates.push_back(cfg);
+        for (const auto &bl: blocks) {
+            cfg.kernel = MatmulKernel::Blocked;
+            cfg.block_i = bl[0];
+            cfg.block_k = bl[1];
+            cfg.block_j = bl[2];
+            candidates.push_back(cfg);
+        }
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    // Tiempo total de cada candidato sumado sobre las formas de cada clase
+    map<ShapeClass, vector<double>> totals;
+
+    for (const auto &s: shapes) {
+        size_t N = s[0], K = s[1], M = s[2];
+        vector<double> a(N * K), b(K * M), c(N * M);
+        for (auto &x: a) x = dist(gen);
+        for (auto &x: b) x = dist(gen);
+
+        auto &total = totals[classify_shape(N, K, M)];
+        total.resize(candidates.size(), 0.0);
+
+        for (size_t ci = 0; ci < candidates.size(); ++ci) {
+            double best = std::numeric_limits<double>::max();
+            for (size_t r = 0; r < repetitions; ++r) {
+                std::fill(c.begin(), c.end(), 0.0);
+                auto t0 = std::chrono::steady_clock::now();
+                matmul_kernel(a.data(), b.data(), c.data(), N, K, M, candidates[ci]);
+                auto t1 = std::chrono::steady_clock::now();
+                best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+            }
+            total[ci] += best;
+        }
+    }
+
+    map<ShapeClass, MatmulConfig> winners;
+    for (const auto &[cls, total]: totals) {
+        size_t winner = 0;
+        for (size_t ci = 1; ci < total.size(); ++ci)
+            if (total[ci] < total[winner]) winner = ci;
+        winners[cls] = candidates[winner];
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &[cls, cfg]: winners)
+        tuned[cls] = cfg;
+}
+
+bool MatmulTuner::load(const string &path) {
+    ifstream in(path);
+    if (!in) return false;
+
+    map<ShapeClass, MatmulConfig> loaded;
+    string line;
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        istringstream ss(line);
+        string cls_str, kernel_str;
+        MatmulConfig cfg;
+        ShapeClass cls;
+        if (!(ss >> cls_str >> kernel_str >> cfg.block_i >> cfg.block_k >> cfg.block_j >> cfg.threads))
+            continue;
+        if (!parse_class(cls_str, cls) || !parse_kernel(kernel_str, cfg.kernel))
+            continue;
+        loaded[cls] = cfg;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    tuned = loaded;
+    return true;
+}
+
+bool MatmulTuner::save(const string &path) const {
+    map<ShapeClass, MatmulConfig> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        snapshot = tuned;
+    }
+
+    ofstream out(path);
+    if (!out) return false;
+
+    out << "# shape_class kernel block_i block_k block_j threads\n";
+    for (const auto &[cls, cfg]: snapshot) {
+        out << class_name(cls) << " " << kernel_name(cfg.kernel) << " "
+            << cfg.block_i << " " << cfg.block_k << " " << cfg.block_j << " "
+            << cfg.threads << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+void MatmulTuner::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    tuned.clear();
+}
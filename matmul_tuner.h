@@ -0,0 +1,74 @@
+#ifndef TAREA_01_MATMUL_TUNER_H
+#define TAREA_01_MATMUL_TUNER_H
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Archivo de configuracion por defecto (se puede cambiar con TENSOR_TUNE_FILE)
+const char *const MATMUL_TUNE_FILE = "matmul_tune.cfg";
+
+enum class MatmulKernel {
+    Naive,    // i-j-k clasico
+    RowAxpy,  // i-k-j: recorre b por filas
+    Blocked   // i-k-j por bloques de cache
+};
+
+enum class ShapeClass {
+    SmallBatch,  // pocas filas en a (inferencia por lotes pequeños)
+    TallSkinny,  // salida o dimension interna estrecha (p. ej. 1000 x 10)
+    Square       // resto
+};
+
+struct MatmulConfig {
+    MatmulKernel kernel = MatmulKernel::RowAxpy;
+    size_t block_i = 64;
+    size_t block_k = 128;
+    size_t block_j = 128;
+    size_t threads = 1;
+};
+
+ShapeClass classify_shape(size_t N, size_t K, size_t M);
+
+// c (N x M) = a (N x K) * b (K x M); c debe venir inicializado a cero.
+// Todas las variantes suman en k creciente, por lo que dan el mismo resultado.
+void matmul_kernel(const double *a, const double *b, double *c,
+                   size_t N, size_t K, size_t M, const MatmulConfig &config);
+
+class MatmulTuner {
+private:
+    // tune, load y clear pueden llamarse mientras otros hilos hacen matmul
+    mutable std::mutex mutex;
+    map<ShapeClass, MatmulConfig> tuned;
+
+public:
+    // Instancia global; carga el archivo de configuracion la primera vez
+    static MatmulTuner &instance();
+
+    // Configuracion afinada para la clase de la forma, o la heuristica
+    MatmulConfig config_for(size_t N, size_t K, size_t M) const;
+
+    static MatmulConfig heuristic(size_t N, size_t K, size_t M);
+
+    // Mide las configuraciones candidatas sobre las formas {N, K, M} dadas
+    // y guarda la ganadora de cada clase
+    void tune(const vector<array<size_t, 3>> &shapes, size_t repetitions = 3);
+
+    // Formas representativas de test_final
+    static vector<array<size_t, 3>> default_shapes();
+
+    bool load(const string &path);
+
+    bool save(const string &path) const;
+
+    void clear();
+
+    // Ruta del archivo: TENSOR_TUNE_FILE o MATMUL_TUNE_FILE
+    static string config_path();
+};
+
+#endif //TAREA_01_MATMUL_TUNER_H
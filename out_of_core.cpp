@@ -0,0 +1,170 @@
+#include "out_of_core.h"
+#include "matmul_tuner.h"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TENSOR_HAVE_MMAP 1
+#else
+#include <future>
+#endif
+
+void save_raw(const Tensor &t, const std::string &path) {
+    ofstream out(path, ios::binary);
+    if (!out)
+        throw std::runtime_error("save_raw: cannot open " + path);
+
+    out.write(reinterpret_cast<const char *>(TensorAccess::data(t)),
+              static_cast<streamsize>(t.shape_product() * sizeof(double)));
+    if (!out)
+        throw std::runtime_error("save_raw: write failed for " + path);
+}
+
+Tensor load_raw(const std::string &path, const std::vector<size_t> &shape) {
+    Tensor t = Tensor::zeros(shape);
+
+    ifstream in(path, ios::binary);
+    if (!in)
+        throw std::runtime_error("load_raw: cannot open " + path);
+
+    in.read(reinterpret_cast<char *>(t.data),
+            static_cast<streamsize>(t.shape_product() * sizeof(double)));
+    if (in.gcount() != static_cast<streamsize>(t.shape_product() * sizeof(double)))
+        throw std::invalid_argument("load_raw: file is smaller than the shape");
+
+    return t;
+}
+
+// Recorre los paneles de A: panel(begin, count, ptr) recibe count filas
+// contiguas a partir de la fila begin.
+using PanelFn = function<void(size_t, size_t, const double *)>;
+
+#ifdef TENSOR_HAVE_MMAP
+
+static void for_each_panel(const std::string &path, size_t rows, size_t K,
+                           size_t panel_rows, const PanelFn &panel) {
+    size_t bytes = rows * K * sizeof(double);
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("matmul_out_of_core: cannot open " + path);
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < bytes) {
+        close(fd);
+        throw std::invalid_argument("matmul_out_of_core: file is smaller than rows x K");
+    }
+
+    void *map = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        throw std::runtime_error("matmul_out_of_core: mmap failed for " + path);
+
+    const double *a = static_cast<const double *>(map);
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t panel_bytes = panel_rows * K * sizeof(double);
+
+    // Rango [begin, begin + len) alineado a paginas, como exige madvise
+    auto advise = [&](size_t begin, size_t len, int advice) {
+        if (begin >= bytes) return;
+        len = std::min(len, bytes - begin);
+        size_t aligned = begin / page * page;
+        madvise(static_cast<char *>(map) + aligned, len + (begin - aligned), advice);
+    };
+
+    madvise(map, bytes, MADV_SEQUENTIAL);
+    advise(0, panel_bytes, MADV_WILLNEED);
+
+    try {
+        for (size_t r = 0; r < rows; r += panel_rows) {
+            size_t count = std::min(panel_rows, rows - r);
+            size_t offset = r * K * sizeof(double);
+
+            // El kernel lee este panel mientras el sistema trae el siguiente
+            advise(offset + panel_bytes, panel_bytes, MADV_WILLNEED);
+            panel(r, count, a + r * K);
+            // Las paginas ya usadas dejan de contar en la memoria del proceso
+            advise(offset, count * K * sizeof(double), MADV_DONTNEED);
+        }
+    } catch (...) {
+        munmap(map, bytes);
+        throw;
+    }
+
+    munmap(map, bytes);
+}
+
+#else
+
+static void for_each_panel(const std::string &path, size_t rows, size_t K,
+                           size_t panel_rows, const PanelFn &panel) {
+    ifstream in(path, ios::binary);
+    if (!in)
+        throw std::runtime_error("matmul_out_of_core: cannot open " + path);
+
+    // Doble buffer: un hilo lee el panel siguiente mientras se calcula el actual
+    vector<double> buffers[2] = {vector<double>(panel_rows * K), vector<double>(panel_rows * K)};
+
+    auto read_panel = [&](size_t r, vector<double> &buf) {
+        size_t count = std::min(panel_rows, rows - r);
+        streamsize n = static_cast<streamsize>(count * K * sizeof(double));
+        in.read(reinterpret_cast<char *>(buf.data()), n);
+        return in.gcount() == n;
+    };
+
+    future<bool> pending = async(launch::async, read_panel, size_t(0), ref(buffers[0]));
+    size_t current = 0;
+
+    for (size_t r = 0; r < rows; r += panel_rows) {
+        if (!pending.get())
+            throw std::invalid_argument("matmul_out_of_core: file is smaller than rows x K");
+
+        size_t next = r + panel_rows;
+        if (next < rows)
+            pending = async(launch::async, read_panel, next, ref(buffers[1 - current]));
+
+        panel(r, std::min(panel_rows, rows - r), buffers[current].data());
+        current = 1 - current;
+    }
+}
+
+#endif
+
+void matmul_out_of_core(const std::string &a_path, size_t rows, size_t K,
+                        const Tensor &b, const std::string &c_path, size_t panel_rows) {
+    if (TensorAccess::dims(b) != 2)
+        throw std::invalid_argument("b must be 2D");
+    if (TensorAccess::shape(b, 0) != K)
+        throw std::invalid_argument("incompatible shapes");
+    if (panel_rows == 0)
+        throw std::invalid_argument("panel_rows must be positive");
+
+    size_t M = TensorAccess::shape(b, 1);
+    panel_rows = std::min(panel_rows, std::max<size_t>(rows, 1));
+
+    ofstream out(c_path, ios::binary);
+    if (!out)
+        throw std::runtime_error("matmul_out_of_core: cannot open " + c_path);
+    if (rows == 0) return;
+
+    // Un solo buffer de salida reutilizado por todos los paneles
+    vector<double> c(panel_rows * M);
+    MatmulConfig config = MatmulTuner::instance().config_for(panel_rows, K, M);
+
+    for_each_panel(a_path, rows, K, panel_rows,
+                   [&](size_t, size_t count, const double *a) {
+                       std::fill(c.begin(), c.begin() + count * M, 0.0);
+                       matmul_kernel(a, TensorAccess::data(b), c.data(), count, K, M, config);
+                       out.write(reinterpret_cast<const char *>(c.data()),
+                                 static_cast<streamsize>(count * M * sizeof(double)));
+                   });
+
+    if (!out)
+        throw std::runtime_error("matmul_out_of_core: write failed for " + c_path);
+}
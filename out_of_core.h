@@ -0,0 +1,24 @@
+#ifndef TAREA_01_OUT_OF_CORE_H
+#define TAREA_01_OUT_OF_CORE_H
+
+#include "tensor.h"
+
+// Filas de A por panel en matmul_out_of_core
+const size_t OUT_OF_CORE_PANEL_ROWS = 4096;
+
+// Guarda los datos del tensor como doubles crudos (orden por filas)
+void save_raw(const Tensor &t, const std::string &path);
+
+// Lee un archivo de doubles crudos con la forma indicada
+Tensor load_raw(const std::string &path, const std::vector<size_t> &shape);
+
+// C (rows x M) = A (rows x K) * B (K x M) con A en el archivo a_path y C
+// escrito en c_path, ambos como doubles crudos. A no se carga entera: se
+// procesa por paneles de panel_rows filas con el kernel de matmul en memoria
+// mientras se pide al sistema el panel siguiente (mmap + madvise en POSIX,
+// un hilo lector con doble buffer en el resto).
+void matmul_out_of_core(const std::string &a_path, size_t rows, size_t K,
+                        const Tensor &b, const std::string &c_path,
+                        size_t panel_rows = OUT_OF_CORE_PANEL_ROWS);
+
+#endif //TAREA_01_OUT_OF_CORE_H
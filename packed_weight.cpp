@@ -0,0 +1,119 @@
+#include "packed_weight.h"
+#include "matmul_tuner.h"
+#include "parallel.h"
+#include "cpu_dispatch.h"
+
+#include <algorithm>
+
+PackedWeight::PackedWeight() {
+    K = 0;
+    M = 0;
+}
+
+PackedWeight::PackedWeight(const Tensor &b) {
+    if (TensorAccess::dims(b) != 2)
+        throw std::invalid_argument("PackedWeight: tensor must be 2D");
+
+    K = TensorAccess::shape(b, 0);
+    M = TensorAccess::shape(b, 1);
+    const double *data = TensorAccess::data(b);
+
+    size_t n_panels = (M + PACK_NR - 1) / PACK_NR;
+    panels.assign(n_panels * K * PACK_NR, 0.0);
+
+    for (size_t p = 0; p < n_panels; ++p) {
+        double *panel = &panels[p * K * PACK_NR];
+        size_t j0 = p * PACK_NR;
+        size_t nc = std::min(PACK_NR, M - j0);
+        for (size_t k = 0; k < K; ++k)
+            for (size_t c = 0; c < nc; ++c)
+                panel[k * PACK_NR + c] = data[k * M + j0 + c];
+    }
+}
+
+size_t PackedWeight::rows() const {
+    return K;
+}
+
+size_t PackedWeight::cols() const {
+    return M;
+}
+
+Tensor PackedWeight::unpack() const {
+    vector<double> values(K * M);
+
+    for (size_t j = 0; j < M; ++j) {
+        const double *panel = &panels[(j / PACK_NR) * K * PACK_NR];
+        for (size_t k = 0; k < K; ++k)
+            values[k * M + j] = panel[k * PACK_NR + j % PACK_NR];
+    }
+
+    return Tensor({K, M}, values);
+}
+
+// El micro-kernel de la tabla SIMD (cpu_dispatch.h) tiene este tamaño
+static_assert(PackedWeight::PACK_MR == 4 && PackedWeight::PACK_NR == 8,
+              "block_4x8 expects 4 x 8 blocks");
+
+// Una fila de a por un panel: PACK_NR acumuladores que se suman en k
+// creciente (mismo resultado que el kernel general y que block_4x8)
+static void packed_row(const double *a, size_t K, const double *panel, double *c, size_t nc) {
+    constexpr size_t NR = PackedWeight::PACK_NR;
+    double acc[NR] = {};
+
+    for (size_t k = 0; k < K; ++k) {
+        const double *bk = panel + k * NR;
+        for (size_t j = 0; j < NR; ++j)
+            acc[j] += a[k] * bk[j];
+    }
+
+    for (size_t j = 0; j < nc; ++j) c[j] = acc[j];
+}
+
+Tensor matmul(const Tensor &a, const PackedWeight &b) {
+    if (TensorAccess::dims(a) != 2)
+        throw std::invalid_argument("both tensors must be 2D");
+    if (TensorAccess::shape(a, 1) != b.K)
+        throw std::invalid_argument("incompatible shapes");
+
+    constexpr size_t MR = PackedWeight::PACK_MR;
+    constexpr size_t NR = PackedWeight::PACK_NR;
+
+    size_t N = TensorAccess::shape(a, 0);
+    size_t K = b.K;
+    size_t M = b.M;
+    size_t n_panels = (M + NR - 1) / NR;
+
+    vector<double> values(N * M, 0.0);
+    const double *a_data = TensorAccess::data(a);
+    const KernelTable &kt = kernels();
+    size_t threads = MatmulTuner::instance().config_for(N, K, M).threads;
+    size_t row_blocks = (N + MR - 1) / MR;
+
+    parallel_for(row_blocks, threads, [&](size_t b0, size_t b1) {
+        for (size_t rb = b0; rb < b1; ++rb) {
+            size_t i = rb * MR;
+            size_t mr = std::min(MR, N - i);
+            const double *a_rows = a_data + i * K;
+
+            for (size_t p = 0; p < n_panels; ++p) {
+                const double *panel = &b.panels[p * K * NR];
+                double *c = &values[i * M + p * NR];
+                size_t nc = std::min(NR, M - p * NR);
+
+                if (mr == MR) {
+                    double tile[MR * NR];
+                    kt.block_4x8(a_rows, K, panel, K, tile);
+                    for (size_t r = 0; r < MR; ++r)
+                        for (size_t j = 0; j < nc; ++j)
+                            c[r * M + j] = tile[r * NR + j];
+                } else {
+                    for (size_t r = 0; r < mr; ++r)
+                        packed_row(a_rows + r * K, K, panel, c + r * M, nc);
+                }
+            }
+        }
+    });
+
+    return Tensor({N, M}, values);
+}
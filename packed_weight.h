@@ -0,0 +1,35 @@
+#ifndef TAREA_01_PACKED_WEIGHT_H
+#define TAREA_01_PACKED_WEIGHT_H
+
+#include "tensor.h"
+
+// Matriz derecha de matmul (K x M) empaquetada una sola vez en paneles de
+// PACK_NR columnas: dentro de cada panel los PACK_NR valores de una fila k
+// son contiguos, de modo que el kernel lee b de forma secuencial. El ultimo
+// panel se rellena con ceros.
+class PackedWeight {
+public:
+    static constexpr size_t PACK_NR = 8;  // columnas por panel
+    static constexpr size_t PACK_MR = 4;  // filas de a por bloque del kernel
+
+private:
+    size_t K;
+    size_t M;
+    vector<double> panels;  // ceil(M / PACK_NR) paneles de K x PACK_NR
+
+public:
+    PackedWeight();
+
+    explicit PackedWeight(const Tensor &b);
+
+    size_t rows() const;
+
+    size_t cols() const;
+
+    // Reconstruye la matriz original
+    Tensor unpack() const;
+
+    friend Tensor matmul(const Tensor &a, const PackedWeight &b);
+};
+
+#endif //TAREA_01_PACKED_WEIGHT_H
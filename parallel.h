@@ -0,0 +1,40 @@
+#ifndef TAREA_01_PARALLEL_H
+#define TAREA_01_PARALLEL_H
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// Numero de hilos disponibles (al menos 1)
+inline size_t hardware_threads() {
+    size_t n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// Reparte el rango [0, n) en bloques contiguos y llama a body(begin, end)
+// en cada uno. Con threads <= 1 se ejecuta en el hilo actual.
+template <typename Body>
+void parallel_for(size_t n, size_t threads, const Body &body) {
+    threads = std::min(threads, n);
+    if (threads <= 1) {
+        if (n > 0) body(size_t(0), n);
+        return;
+    }
+
+    size_t chunk = (n + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+
+    for (size_t t = 1; t < threads; ++t) {
+        size_t begin = t * chunk;
+        size_t end = std::min(n, begin + chunk);
+        if (begin >= end) break;
+        workers.emplace_back([&body, begin, end]() { body(begin, end); });
+    }
+
+    body(size_t(0), std::min(n, chunk));
+
+    for (auto &w: workers) w.join();
+}
+
+#endif //TAREA_01_PARALLEL_H
@@ -0,0 +1,153 @@
+// Cuerpo comun de los kernels SIMD. Cada kernels_<isa>.cpp define el struct
+// Vec con las operaciones de su conjunto de instrucciones y el nombre del
+// namespace en TENSOR_KERNEL_NS antes de incluir este archivo.
+//
+// Solo se incluye <cstddef>: estos archivos se compilan con flags de
+// arquitectura y las funciones inline de otras cabeceras podrian terminar
+// usandose desde el resto del binario en una CPU sin esas instrucciones.
+
+#ifndef TENSOR_KERNEL_NS
+#error "define TENSOR_KERNEL_NS before including simd_kernels_impl.h"
+#endif
+
+#include <cstddef>
+
+namespace TENSOR_KERNEL_NS {
+    // Cuatro acumuladores vectoriales independientes
+    double dot(const double *a, const double *b, size_t n) {
+        constexpr size_t W = Vec::W;
+        typename Vec::T acc0 = Vec::zero();
+        typename Vec::T acc1 = Vec::zero();
+        typename Vec::T acc2 = Vec::zero();
+        typename Vec::T acc3 = Vec::zero();
+
+        size_t i = 0;
+        for (; i + 4 * W <= n; i += 4 * W) {
+            acc0 = Vec::fmadd(Vec::load(a + i), Vec::load(b + i), acc0);
+            acc1 = Vec::fmadd(Vec::load(a + i + W), Vec::load(b + i + W), acc1);
+            acc2 = Vec::fmadd(Vec::load(a + i + 2 * W), Vec::load(b + i + 2 * W), acc2);
+            acc3 = Vec::fmadd(Vec::load(a + i + 3 * W), Vec::load(b + i + 3 * W), acc3);
+        }
+        for (; i + W <= n; i += W)
+            acc0 = Vec::fmadd(Vec::load(a + i), Vec::load(b + i), acc0);
+
+        double result = Vec::hsum(Vec::add(Vec::add(acc0, acc1), Vec::add(acc2, acc3)));
+        for (; i < n; ++i) result += a[i] * b[i];
+        return result;
+    }
+
+    // Multiplicacion y suma separadas (sin FMA) para redondear igual que
+    // la variante escalar
+    void axpy(double alpha, const double *x, double *y, size_t n) {
+        constexpr size_t W = Vec::W;
+        typename Vec::T va = Vec::set1(alpha);
+
+        size_t i = 0;
+        for (; i + W <= n; i += W)
+            Vec::store(y + i, Vec::add(Vec::load(y + i), Vec::mul(va, Vec::load(x + i))));
+        for (; i < n; ++i) y[i] += alpha * x[i];
+    }
+
+    void add(const double *a, const double *b, double *out, size_t n) {
+        size_t i = 0;
+        for (; i + Vec::W <= n; i += Vec::W)
+            Vec::store(out + i, Vec::add(Vec::load(a + i), Vec::load(b + i)));
+        for (; i < n; ++i) out[i] = a[i] + b[i];
+    }
+
+    void sub(const double *a, const double *b, double *out, size_t n) {
+        size_t i = 0;
+        for (; i + Vec::W <= n; i += Vec::W)
+            Vec::store(out + i, Vec::sub(Vec::load(a + i), Vec::load(b + i)));
+        for (; i < n; ++i) out[i] = a[i] - b[i];
+    }
+
+    void mul(const double *a, const double *b, double *out, size_t n) {
+        size_t i = 0;
+        for (; i + Vec::W <= n; i += Vec::W)
+            Vec::store(out + i, Vec::mul(Vec::load(a + i), Vec::load(b + i)));
+        for (; i < n; ++i) out[i] = a[i] * b[i];
+    }
+
+    void scale(const double *a, double value, double *out, size_t n) {
+        typename Vec::T v = Vec::set1(value);
+        size_t i = 0;
+        for (; i + Vec::W <= n; i += Vec::W)
+            Vec::store(out + i, Vec::mul(Vec::load(a + i), v));
+        for (; i < n; ++i) out[i] = a[i] * value;
+    }
+
+    // Acumuladores 4 x 8 en registros; multiplicacion y suma separadas, como axpy
+    void block_4x8(const double *a, size_t lda, const double *panel, size_t K, double *c) {
+        constexpr size_t W = Vec::W;
+        constexpr size_t NV = 8 / W;
+        typename Vec::T acc[4][NV];
+        for (size_t r = 0; r < 4; ++r)
+            for (size_t v = 0; v < NV; ++v) acc[r][v] = Vec::zero();
+
+        for (size_t k = 0; k < K; ++k) {
+            typename Vec::T b[NV];
+            for (size_t v = 0; v < NV; ++v) b[v] = Vec::load(panel + k * 8 + v * W);
+            for (size_t r = 0; r < 4; ++r) {
+                typename Vec::T av = Vec::set1(a[r * lda + k]);
+                for (size_t v = 0; v < NV; ++v)
+                    acc[r][v] = Vec::add(acc[r][v], Vec::mul(av, b[v]));
+            }
+        }
+
+        for (size_t r = 0; r < 4; ++r)
+            for (size_t v = 0; v < NV; ++v) Vec::store(c + r * 8 + v * W, acc[r][v]);
+    }
+
+    // NB bloques de W filas de gemv. Cada bloque W x W de a se traspone para
+    // que cada lane lleve la suma de una fila en k creciente
+    template <size_t NB>
+    static void gemv_rows(const double *a, const double *x, double *y, size_t K) {
+        constexpr size_t W = Vec::W;
+        typename Vec::T acc[NB];
+        for (size_t b = 0; b < NB; ++b) acc[b] = Vec::zero();
+
+        size_t k = 0;
+        for (; k + W <= K; k += W) {
+            for (size_t b = 0; b < NB; ++b) {
+                typename Vec::T v[W];
+                for (size_t r = 0; r < W; ++r) v[r] = Vec::load(a + (b * W + r) * K + k);
+                Vec::transpose(v);
+                for (size_t j = 0; j < W; ++j)
+                    acc[b] = Vec::add(acc[b], Vec::mul(v[j], Vec::set1(x[k + j])));
+            }
+        }
+        for (size_t b = 0; b < NB; ++b) Vec::store(y + b * W, acc[b]);
+
+        // Columnas sobrantes, siguiendo en k creciente
+        for (size_t r = 0; r < NB * W; ++r)
+            for (size_t kk = k; kk < K; ++kk) y[r] += a[r * K + kk] * x[kk];
+    }
+
+    // Multiplicacion y suma separadas: mismo resultado que la escalar.
+    // Se leen 8 filas a la vez: bastan para cubrir la latencia de la suma y,
+    // con filas de un multiplo de 4 KB, mas filas caerian en el mismo
+    // conjunto de la cache L1.
+    void gemv(const double *a, const double *x, double *y, size_t N, size_t K) {
+        constexpr size_t W = Vec::W;
+        constexpr size_t NB = 8 / W;
+        size_t i = 0;
+        for (; i + NB * W <= N; i += NB * W) gemv_rows<NB>(a + i * K, x, y + i, K);
+        for (; i + W <= N; i += W) gemv_rows<1>(a + i * K, x, y + i, K);
+        for (; i < N; ++i) {
+            const double *row = a + i * K;
+            double sum = 0.0;
+            for (size_t k = 0; k < K; ++k) sum += row[k] * x[k];
+            y[i] = sum;
+        }
+    }
+
+    // max(x, 0) devuelve 0 para NaN y -0.0, igual que x > 0 ? x : 0
+    void relu(const double *a, double *out, size_t n) {
+        typename Vec::T zero = Vec::zero();
+        size_t i = 0;
+        for (; i + Vec::W <= n; i += Vec::W)
+            Vec::store(out + i, Vec::max(Vec::load(a + i), zero));
+        for (; i < n; ++i) out[i] = a[i] > 0 ? a[i] : 0;
+    }
+}
@@ -0,0 +1,108 @@
+#include "sparse_tensor.h"
+#include "matmul_tuner.h"
+#include "parallel.h"
+#include "cpu_dispatch.h"
+
+#include <cmath>
+
+SparseTensor::SparseTensor() {
+    rows = 0;
+    cols = 0;
+    row_ptr.push_back(0);
+}
+
+SparseTensor SparseTensor::from_dense(const Tensor &t, double threshold) {
+    if (TensorAccess::dims(t) != 2)
+        throw std::invalid_argument("from_dense: tensor must be 2D");
+
+    const double *data = TensorAccess::data(t);
+    SparseTensor s;
+    s.rows = TensorAccess::shape(t, 0);
+    s.cols = TensorAccess::shape(t, 1);
+    s.row_ptr.assign(s.rows + 1, 0);
+
+    for (size_t i = 0; i < s.rows; ++i) {
+        for (size_t j = 0; j < s.cols; ++j) {
+            double x = data[i * s.cols + j];
+            if (std::fabs(x) > threshold) {
+                s.values.push_back(x);
+                s.col_index.push_back(j);
+            }
+        }
+        s.row_ptr[i + 1] = s.values.size();
+    }
+
+    return s;
+}
+
+Tensor SparseTensor::to_dense() const {
+    vector<double> values_(rows * cols, 0.0);
+
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t p = row_ptr[i]; p < row_ptr[i + 1]; ++p)
+            values_[i * cols + col_index[p]] = values[p];
+
+    return Tensor({rows, cols}, values_);
+}
+
+double SparseTensor::density_of(const Tensor &t, double threshold) {
+    if (TensorAccess::dims(t) == 0) return 0.0;
+
+    size_t n = t.shape_product();
+    if (n == 0) return 0.0;
+
+    const double *data = TensorAccess::data(t);
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i)
+        if (std::fabs(data[i]) > threshold) ++count;
+
+    return static_cast<double>(count) / n;
+}
+
+size_t SparseTensor::nnz() const {
+    return values.size();
+}
+
+double SparseTensor::density() const {
+    if (rows * cols == 0) return 0.0;
+    return static_cast<double>(values.size()) / (rows * cols);
+}
+
+Tensor matmul(const SparseTensor &a, const Tensor &b) {
+    if (TensorAccess::dims(b) != 2)
+        throw std::invalid_argument("both tensors must be 2D");
+
+    size_t N = a.rows;
+    size_t K = a.cols;
+    size_t M = TensorAccess::shape(b, 1);
+
+    if (K != TensorAccess::shape(b, 0))
+        throw std::invalid_argument("incompatible shapes");
+
+    vector<double> values(N * M, 0.0);
+
+    // Cada no nulo a(i,k) suma a(i,k) * b(k,:) a la fila i del resultado.
+    // Los k se recorren en orden creciente, igual que en el kernel denso,
+    // por lo que el resultado es identico. Las filas se reparten entre
+    // hilos como en el matmul denso de la misma forma.
+    const double *b_data = TensorAccess::data(b);
+    const KernelTable &kt = kernels();
+    size_t threads = MatmulTuner::instance().config_for(N, K, M).threads;
+
+    parallel_for(N, threads, [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
+            double *out = &values[i * M];
+            for (size_t p = a.row_ptr[i]; p < a.row_ptr[i + 1]; ++p)
+                kt.axpy(a.values[p], b_data + a.col_index[p] * M, out, M);
+        }
+    });
+
+    return Tensor({N, M}, values);
+}
+
+Tensor matmul_auto(const Tensor &a, const Tensor &b) {
+    if (SparseTensor::density_of(a) < SPARSE_DENSITY_THRESHOLD)
+        return matmul(SparseTensor::from_dense(a), b);
+
+    return matmul(a, b);
+}
@@ -0,0 +1,42 @@
+#ifndef TAREA_01_SPARSE_TENSOR_H
+#define TAREA_01_SPARSE_TENSOR_H
+
+#include "tensor.h"
+
+// Por debajo de esta densidad matmul_auto usa el kernel disperso. Medido
+// con 1000x400 * 400x100 y los kernels SIMD: el disperso (con from_dense
+// incluido) empata con el denso cerca de 0.45; a 0.1 es unas 3.5x mas rapido
+const double SPARSE_DENSITY_THRESHOLD = 0.4;
+
+// Matriz 2D dispersa en formato CSR (Compressed Sparse Row)
+class SparseTensor {
+private:
+    size_t rows;
+    size_t cols;
+    vector<double> values;     // valores no nulos, fila por fila
+    vector<size_t> col_index;  // columna de cada valor
+    vector<size_t> row_ptr;    // inicio de cada fila en values (rows + 1)
+
+public:
+    SparseTensor();
+
+    // Conversion desde un Tensor 2D: se guardan solo los |x| > threshold
+    static SparseTensor from_dense(const Tensor &t, double threshold = 0.0);
+
+    Tensor to_dense() const;
+
+    // Fraccion de elementos con |x| > threshold en un Tensor
+    static double density_of(const Tensor &t, double threshold = 0.0);
+
+    size_t nnz() const;
+
+    double density() const;
+
+    // Disperso x denso: (n x k) * (k x m), se saltan los ceros de a
+    friend Tensor matmul(const SparseTensor &a, const Tensor &b);
+};
+
+// Elige el kernel disperso o denso segun la densidad de a
+Tensor matmul_auto(const Tensor &a, const Tensor &b);
+
+#endif //TAREA_01_SPARSE_TENSOR_H
@@ -0,0 +1,296 @@
+#ifndef TAREA_01_STATIC_TENSOR_H
+#define TAREA_01_STATIC_TENSOR_H
+
+#include "tensor.h"
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+// Tensor de forma fija en tiempo de compilacion (1D a 3D) con los datos en
+// linea (sin memoria dinamica). Las formas se comprueban con static_assert
+// y los kernels se despliegan con index_sequence.
+template <typename T, size_t... Dims>
+class StaticTensor {
+    static_assert(sizeof...(Dims) >= 1 && sizeof...(Dims) <= 3,
+                  "Shape size must be between 1 and 3");
+    static_assert(((Dims > 0) && ...), "Dimensions must be positive");
+
+public:
+    static constexpr size_t dims = sizeof...(Dims);
+    static constexpr size_t size = (Dims * ...);
+    static constexpr std::array<size_t, dims> shape = {Dims...};
+
+    std::array<T, size> data{};
+
+    constexpr StaticTensor() = default;
+
+    constexpr explicit StaticTensor(const std::array<T, size> &values) : data(values) {}
+
+    static constexpr StaticTensor zeros() {
+        return StaticTensor();
+    }
+
+    static constexpr StaticTensor ones() {
+        StaticTensor t;
+        for (size_t i = 0; i < size; ++i) t.data[i] = T(1);
+        return t;
+    }
+
+    constexpr T &operator[](size_t i) { return data[i]; }
+
+    constexpr const T &operator[](size_t i) const { return data[i]; }
+
+    // Acceso (fila, columna) para 2D
+    constexpr T &operator()(size_t i, size_t j) {
+        static_assert(dims == 2, "operator(i, j) requires a 2D tensor");
+        return data[i * shape[1] + j];
+    }
+
+    constexpr const T &operator()(size_t i, size_t j) const {
+        static_assert(dims == 2, "operator(i, j) requires a 2D tensor");
+        return data[i * shape[1] + j];
+    }
+
+    // f se aplica elemento a elemento (desplegado)
+    template <typename F> requires (!std::is_base_of_v<TensorTransform, F>)
+    constexpr StaticTensor apply(F f) const {
+        return apply_impl(f, std::make_index_sequence<size>{});
+    }
+
+    StaticTensor apply(const TensorTransform &transform) const {
+        return apply([&transform](T x) { return static_cast<T>(transform.apply(x)); });
+    }
+
+    // Conversion a Tensor dinamico
+    Tensor to_tensor() const {
+        return Tensor({Dims...}, vector<double>(data.begin(), data.end()));
+    }
+
+    // Conversion desde Tensor dinamico (la forma se comprueba en ejecucion)
+    static StaticTensor from_tensor(const Tensor &t);
+
+private:
+    template <typename F, size_t... I>
+    constexpr StaticTensor apply_impl(F f, std::index_sequence<I...>) const {
+        StaticTensor out;
+        ((out.data[I] = f(data[I])), ...);
+        return out;
+    }
+};
+
+template <typename T, size_t... Dims>
+StaticTensor<T, Dims...> StaticTensor<T, Dims...>::from_tensor(const Tensor &t) {
+    if (TensorAccess::dims(t) != dims)
+        throw std::invalid_argument("from_tensor: dimensions must be equal");
+    for (size_t d = 0; d < dims; ++d)
+        if (TensorAccess::shape(t, d) != shape[d])
+            throw std::invalid_argument("from_tensor: incompatible shapes");
+
+    StaticTensor out;
+    const double *src = TensorAccess::data(t);
+    for (size_t i = 0; i < size; ++i) out.data[i] = static_cast<T>(src[i]);
+    return out;
+}
+
+namespace static_tensor_detail {
+    template <typename Op, typename T, size_t N, size_t... I>
+    constexpr void elementwise(const std::array<T, N> &a, const std::array<T, N> &b,
+                               std::array<T, N> &out, Op op, std::index_sequence<I...>) {
+        ((out[I] = op(a[I], b[I])), ...);
+    }
+
+    // (R x C) op (1 x C): b se repite por filas
+    template <typename Op, typename T, size_t R, size_t C, size_t... I>
+    constexpr void broadcast_rows(const std::array<T, R * C> &a, const std::array<T, C> &b,
+                                  std::array<T, R * C> &out, Op op, std::index_sequence<I...>) {
+        ((out[I] = op(a[I], b[I % C])), ...);
+    }
+
+    // Producto de la fila i de a por la columna j de b (desplegado en k)
+    template <typename T, size_t K, size_t M, size_t... Ks>
+    constexpr T row_col(const T *a_row, const T *b, size_t j, std::index_sequence<Ks...>) {
+        T sum = T(0);
+        ((sum += a_row[Ks] * b[Ks * M + j]), ...);
+        return sum;
+    }
+
+    struct Add { template <typename T> constexpr T operator()(T x, T y) const { return x + y; } };
+    struct Sub { template <typename T> constexpr T operator()(T x, T y) const { return x - y; } };
+    struct Mul { template <typename T> constexpr T operator()(T x, T y) const { return x * y; } };
+}
+
+// Operaciones con la misma forma
+
+template <typename T, size_t... Dims>
+constexpr StaticTensor<T, Dims...> operator+(const StaticTensor<T, Dims...> &a,
+                                             const StaticTensor<T, Dims...> &b) {
+    StaticTensor<T, Dims...> out;
+    static_tensor_detail::elementwise(a.data, b.data, out.data, static_tensor_detail::Add{},
+                                      std::make_index_sequence<StaticTensor<T, Dims...>::size>{});
+    return out;
+}
+
+template <typename T, size_t... Dims>
+constexpr StaticTensor<T, Dims...> operator-(const StaticTensor<T, Dims...> &a,
+                                             const StaticTensor<T, Dims...> &b) {
+    StaticTensor<T, Dims...> out;
+    static_tensor_detail::elementwise(a.data, b.data, out.data, static_tensor_detail::Sub{},
+                                      std::make_index_sequence<StaticTensor<T, Dims...>::size>{});
+    return out;
+}
+
+template <typename T, size_t... Dims>
+constexpr StaticTensor<T, Dims...> operator*(const StaticTensor<T, Dims...> &a,
+                                             const StaticTensor<T, Dims...> &b) {
+    StaticTensor<T, Dims...> out;
+    static_tensor_detail::elementwise(a.data, b.data, out.data, static_tensor_detail::Mul{},
+                                      std::make_index_sequence<StaticTensor<T, Dims...>::size>{});
+    return out;
+}
+
+// Broadcasting (n x m) + (1 x m)
+
+template <typename T, size_t R, size_t C> requires (R > 1)
+constexpr StaticTensor<T, R, C> operator+(const StaticTensor<T, R, C> &a,
+                                          const StaticTensor<T, 1, C> &b) {
+    StaticTensor<T, R, C> out;
+    static_tensor_detail::broadcast_rows<static_tensor_detail::Add, T, R, C>(
+        a.data, b.data, out.data, static_tensor_detail::Add{}, std::make_index_sequence<R * C>{});
+    return out;
+}
+
+template <typename T, size_t R, size_t C> requires (R > 1)
+constexpr StaticTensor<T, R, C> operator-(const StaticTensor<T, R, C> &a,
+                                          const StaticTensor<T, 1, C> &b) {
+    StaticTensor<T, R, C> out;
+    static_tensor_detail::broadcast_rows<static_tensor_detail::Sub, T, R, C>(
+        a.data, b.data, out.data, static_tensor_detail::Sub{}, std::make_index_sequence<R * C>{});
+    return out;
+}
+
+// Multiplicacion matricial (N x K) * (K x M); la forma se valida al compilar
+
+template <typename T, size_t N, size_t K, size_t M>
+constexpr StaticTensor<T, N, M> matmul(const StaticTensor<T, N, K> &a,
+                                       const StaticTensor<T, K, M> &b) {
+    StaticTensor<T, N, M> out;
+    for (size_t i = 0; i < N; ++i)
+        for (size_t j = 0; j < M; ++j)
+            out.data[i * M + j] = static_tensor_detail::row_col<T, K, M>(
+                a.data.data() + i * K, b.data.data(), j, std::make_index_sequence<K>{});
+    return out;
+}
+
+template <typename T, size_t N>
+constexpr StaticTensor<T, 1> dot(const StaticTensor<T, N> &a, const StaticTensor<T, N> &b) {
+    StaticTensor<T, 1> out;
+    for (size_t i = 0; i < N; ++i) out.data[0] += a.data[i] * b.data[i];
+    return out;
+}
+
+// Interoperabilidad con Tensor dinamico
+
+// (n x C) op (1 x C) o, con row_left, (1 x C) op (n x C): la fila estatica
+// se repite sobre cada fila del Tensor, como en los operadores de Tensor
+template <size_t C, typename Op>
+Tensor broadcast_row(const Tensor &a, const StaticTensor<double, 1, C> &row, bool row_left,
+                     Op op, const char *name) {
+    if (TensorAccess::dims(a) != 2 || TensorAccess::shape(a, 1) != C)
+        throw std::invalid_argument(std::string(name) + ": incompatible shapes");
+
+    size_t rows = TensorAccess::shape(a, 0);
+    const double *src = TensorAccess::data(a);
+    vector<double> values(rows * C);
+
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t j = 0; j < C; ++j)
+            values[i * C + j] = row_left ? op(row.data[j], src[i * C + j])
+                                         : op(src[i * C + j], row.data[j]);
+
+    return Tensor({rows, C}, values);
+}
+
+// (n x C) + (1 x C): bias estatico sobre un Tensor
+template <size_t C>
+Tensor operator+(const Tensor &a, const StaticTensor<double, 1, C> &b) {
+    return broadcast_row(a, b, false, [](double x, double y) { return x + y; }, "operator+");
+}
+
+template <size_t C>
+Tensor operator-(const Tensor &a, const StaticTensor<double, 1, C> &b) {
+    return broadcast_row(a, b, false, [](double x, double y) { return x - y; }, "operator-");
+}
+
+template <size_t C>
+Tensor operator*(const Tensor &a, const StaticTensor<double, 1, C> &b) {
+    return broadcast_row(a, b, false, [](double x, double y) { return x * y; }, "operator*");
+}
+
+// (1 x C) op (n x C) con la fila estatica a la izquierda
+template <size_t C>
+Tensor operator+(const StaticTensor<double, 1, C> &a, const Tensor &b) {
+    return broadcast_row(b, a, true, [](double x, double y) { return x + y; }, "operator+");
+}
+
+template <size_t C>
+Tensor operator-(const StaticTensor<double, 1, C> &a, const Tensor &b) {
+    return broadcast_row(b, a, true, [](double x, double y) { return x - y; }, "operator-");
+}
+
+template <size_t C>
+Tensor operator*(const StaticTensor<double, 1, C> &a, const Tensor &b) {
+    return broadcast_row(b, a, true, [](double x, double y) { return x * y; }, "operator*");
+}
+
+// (n x K) * (K x M) con el operando derecho estatico
+template <size_t K, size_t M>
+Tensor matmul(const Tensor &a, const StaticTensor<double, K, M> &b) {
+    if (TensorAccess::dims(a) != 2 || TensorAccess::shape(a, 1) != K)
+        throw std::invalid_argument("incompatible shapes");
+
+    size_t N = TensorAccess::shape(a, 0);
+    const double *src = TensorAccess::data(a);
+    vector<double> values(N * M, 0.0);
+
+    for (size_t i = 0; i < N; ++i) {
+        double *out = &values[i * M];
+        for (size_t k = 0; k < K; ++k) {
+            double v = src[i * K + k];
+            for (size_t j = 0; j < M; ++j)
+                out[j] += v * b.data[k * M + j];
+        }
+    }
+
+    return Tensor({N, M}, values);
+}
+
+// (N x K) * (K x m) con el operando izquierdo estatico
+template <size_t N, size_t K>
+Tensor matmul(const StaticTensor<double, N, K> &a, const Tensor &b) {
+    if (TensorAccess::dims(b) != 2 || TensorAccess::shape(b, 0) != K)
+        throw std::invalid_argument("incompatible shapes");
+
+    size_t M = TensorAccess::shape(b, 1);
+    const double *src = TensorAccess::data(b);
+    vector<double> values(N * M, 0.0);
+
+    for (size_t i = 0; i < N; ++i) {
+        double *out = &values[i * M];
+        for (size_t k = 0; k < K; ++k) {
+            double v = a.data[i * K + k];
+            const double *row = src + k * M;
+            for (size_t j = 0; j < M; ++j)
+                out[j] += v * row[j];
+        }
+    }
+
+    return Tensor({N, M}, values);
+}
+
+template <typename T, size_t... Dims>
+std::ostream &operator<<(std::ostream &os, const StaticTensor<T, Dims...> &t) {
+    return os << t.to_tensor();
+}
+
+#endif //TAREA_01_STATIC_TENSOR_H
@@ -0,0 +1,173 @@
+#include "task_graph.h"
+
+// TensorFuture
+
+TensorFuture::TensorFuture(shared_ptr<TaskNode> node) : node(std::move(node)) {}
+
+void TensorFuture::wait() const {
+    if (!node)
+        throw std::invalid_argument("wait: empty future");
+
+    unique_lock<mutex> lock(node->m);
+    node->cv.wait(lock, [this]() { return node->done; });
+}
+
+Tensor TensorFuture::get() const {
+    wait();
+    if (node->error) rethrow_exception(node->error);
+    return node->result;
+}
+
+bool TensorFuture::ready() const {
+    if (!node) return false;
+
+    lock_guard<mutex> lock(node->m);
+    return node->done;
+}
+
+// TaskGraph
+
+TaskGraph::TaskGraph(size_t threads) : in_flight(0), pool(threads == 0 ? 1 : threads) {}
+
+TaskGraph::~TaskGraph() {
+    wait_all();
+}
+
+void TaskGraph::wait_all() {
+    unique_lock<mutex> lock(m);
+    idle_cv.wait(lock, [this]() { return in_flight == 0; });
+}
+
+TensorFuture TaskGraph::submit(function<Tensor(const vector<const Tensor *> &)> op,
+                               const vector<TensorFuture> &deps) {
+    auto node = make_shared<TaskNode>();
+    node->op = std::move(op);
+
+    for (const auto &d: deps) {
+        if (!d.node)
+            throw std::invalid_argument("submit: empty dependency");
+        node->deps.push_back(d.node);
+    }
+
+    bool ready;
+    {
+        lock_guard<mutex> lock(m);
+        ++in_flight;
+        for (const auto &d: node->deps) {
+            if (!d->done) {
+                d->dependents.push_back(node);
+                ++node->pending;
+            }
+        }
+        ready = node->pending == 0;
+    }
+
+    if (ready) schedule(node);
+    return TensorFuture(node);
+}
+
+void TaskGraph::schedule(const shared_ptr<TaskNode> &node) {
+    pool.submit([this, node]() { run(node); });
+}
+
+void TaskGraph::run(const shared_ptr<TaskNode> &node) {
+    Tensor result;
+    exception_ptr error;
+
+    // Un error en una dependencia se propaga sin ejecutar la operacion
+    for (const auto &d: node->deps)
+        if (d->error) error = d->error;
+
+    if (!error) {
+        try {
+            vector<const Tensor *> inputs;
+            inputs.reserve(node->deps.size());
+            for (const auto &d: node->deps) inputs.push_back(&d->result);
+            result = node->op(inputs);
+        } catch (...) {
+            error = current_exception();
+        }
+    }
+
+    vector<shared_ptr<TaskNode>> ready;
+    {
+        lock_guard<mutex> lock(m);
+        {
+            lock_guard<mutex> node_lock(node->m);
+            node->result = std::move(result);
+            node->error = error;
+            node->done = true;
+        }
+        node->cv.notify_all();
+
+        for (auto &dep: node->dependents)
+            if (--dep->pending == 0) ready.push_back(dep);
+        node->dependents.clear();
+
+        // Las entradas ya no hacen falta y no se mantienen vivas; op se
+        // conserva porque view guarda en ella el nodo de origen
+        node->deps.clear();
+    }
+
+    for (const auto &r: ready) schedule(r);
+
+    {
+        lock_guard<mutex> lock(m);
+        --in_flight;
+    }
+    idle_cv.notify_all();
+}
+
+// Operaciones
+
+TensorFuture TaskGraph::constant(Tensor t) {
+    auto value = make_shared<Tensor>(std::move(t));
+    return submit([value](const vector<const Tensor *> &) {
+        return std::move(*value);
+    }, {});
+}
+
+TensorFuture TaskGraph::random(const vector<size_t> &shape, double min, double max) {
+    return submit([shape, min, max](const vector<const Tensor *> &) {
+        return Tensor::random(shape, min, max);
+    }, {});
+}
+
+TensorFuture TaskGraph::matmul(const TensorFuture &a, const TensorFuture &b) {
+    return submit([](const vector<const Tensor *> &in) {
+        return ::matmul(*in[0], *in[1]);
+    }, {a, b});
+}
+
+TensorFuture TaskGraph::add(const TensorFuture &a, const TensorFuture &b) {
+    return submit([](const vector<const Tensor *> &in) {
+        return *in[0] + *in[1];
+    }, {a, b});
+}
+
+TensorFuture TaskGraph::sub(const TensorFuture &a, const TensorFuture &b) {
+    return submit([](const vector<const Tensor *> &in) {
+        return *in[0] - *in[1];
+    }, {a, b});
+}
+
+TensorFuture TaskGraph::mul(const TensorFuture &a, const TensorFuture &b) {
+    return submit([](const vector<const Tensor *> &in) {
+        return *in[0] * *in[1];
+    }, {a, b});
+}
+
+TensorFuture TaskGraph::apply(const TensorFuture &a, const TensorTransform &transform) {
+    const TensorTransform *t = &transform;
+    return submit([t](const vector<const Tensor *> &in) {
+        return in[0]->apply(*t);
+    }, {a});
+}
+
+TensorFuture TaskGraph::view(const TensorFuture &a, const vector<size_t> &shape) {
+    // La vista no copia los datos: la lambda guarda el nodo de a
+    shared_ptr<TaskNode> source = a.node;
+    return submit([shape, source](const vector<const Tensor *> &) {
+        return source->result.view(shape);
+    }, {a});
+}
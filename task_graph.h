@@ -0,0 +1,96 @@
+#ifndef TAREA_01_TASK_GRAPH_H
+#define TAREA_01_TASK_GRAPH_H
+
+#include "tensor.h"
+#include "thread_pool.h"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+class TaskGraph;
+
+// Nodo del grafo: una operacion, sus dependencias y su resultado
+struct TaskNode {
+    function<Tensor(const vector<const Tensor *> &)> op;
+    vector<shared_ptr<TaskNode>> deps;        // se vacian al terminar
+    vector<shared_ptr<TaskNode>> dependents;  // protegido por el mutex del grafo
+    size_t pending = 0;                       // dependencias sin terminar
+
+    Tensor result;
+    exception_ptr error;
+    bool done = false;
+    mutex m;
+    condition_variable cv;
+};
+
+// Resultado diferido de una operacion del grafo
+class TensorFuture {
+private:
+    shared_ptr<TaskNode> node;
+
+    friend class TaskGraph;
+
+public:
+    TensorFuture() = default;
+
+    explicit TensorFuture(shared_ptr<TaskNode> node);
+
+    // Bloquea hasta que el nodo termine
+    void wait() const;
+
+    // Espera y devuelve una copia del resultado (relanza la excepcion de la
+    // operacion). Es una copia porque el nodo puede pertenecer solo al future.
+    Tensor get() const;
+
+    bool ready() const;
+};
+
+// Grafo de dependencias entre operaciones de tensores. Cada operacion se
+// registra al llamarla y se ejecuta en el pool cuando sus entradas estan
+// listas, de modo que las ramas independientes corren en paralelo.
+class TaskGraph {
+private:
+    mutex m;
+    condition_variable idle_cv;
+    size_t in_flight;
+    ThreadPool pool;
+
+    void schedule(const shared_ptr<TaskNode> &node);
+
+    void run(const shared_ptr<TaskNode> &node);
+
+public:
+    explicit TaskGraph(size_t threads = thread::hardware_concurrency());
+
+    // Espera a que terminen todas las operaciones registradas
+    ~TaskGraph();
+
+    // Operacion generica: op recibe los resultados de deps en orden
+    TensorFuture submit(function<Tensor(const vector<const Tensor *> &)> op,
+                        const vector<TensorFuture> &deps);
+
+    TensorFuture constant(Tensor t);
+
+    TensorFuture random(const vector<size_t> &shape, double min, double max);
+
+    TensorFuture matmul(const TensorFuture &a, const TensorFuture &b);
+
+    TensorFuture add(const TensorFuture &a, const TensorFuture &b);
+
+    TensorFuture sub(const TensorFuture &a, const TensorFuture &b);
+
+    TensorFuture mul(const TensorFuture &a, const TensorFuture &b);
+
+    // transform debe seguir vivo hasta que la operacion termine
+    TensorFuture apply(const TensorFuture &a, const TensorTransform &transform);
+
+    // La vista comparte datos con a; el nodo de a se mantiene vivo
+    TensorFuture view(const TensorFuture &a, const vector<size_t> &shape);
+
+    void wait_all();
+};
+
+#endif //TAREA_01_TASK_GRAPH_H
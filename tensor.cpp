@@ -3,6 +3,9 @@
 //
 
 #include "tensor.h"
+#include "matmul_tuner.h"
+#include "vector_kernels.h"
+#include "cpu_dispatch.h"
 
 Tensor::Tensor() {
     shape = nullptr;
@@ -191,10 +194,8 @@ Tensor Tensor::operator+(const Tensor &other) const {
         vector<size_t> out_shape(dims);
         for (size_t d = 0; d < dims; ++d) out_shape[d] = shape[d];
 
-        vector<double> values;
-
-        for (size_t i = 0; i < shape_product(); ++i)
-            values.emplace_back(data[i] + other.data[i]);
+        vector<double> values(shape_product());
+        kernels().add(data, other.data, values.data(), values.size());
 
         return Tensor(out_shape, values);
     }
@@ -208,17 +209,17 @@ Tensor Tensor::operator+(const Tensor &other) const {
 
         // (n x m) + (1 x m)
         if (rB == 1 && cA == cB) {
+            values.resize(rA * cA);
             for (size_t i = 0; i < rA; ++i)
-                for (size_t j = 0; j < cA; ++j)
-                    values.emplace_back(data[i * cA + j] + other.data[j]);
+                kernels().add(data + i * cA, other.data, values.data() + i * cA, cA);
             return Tensor({rA, cA}, values);
         }
 
         // (1 x m) + (n x m)
         if (rA == 1 && cA == cB) {
+            values.resize(rB * cB);
             for (size_t i = 0; i < rB; ++i)
-                for (size_t j = 0; j < cB; ++j)
-                    values.push_back(data[j] + other.data[i * cB + j]);
+                kernels().add(data, other.data + i * cB, values.data() + i * cB, cB);
             return Tensor({rB, cB}, values);
         }
     }
@@ -226,7 +227,7 @@ Tensor Tensor::operator+(const Tensor &other) const {
     throw std::invalid_argument("operator+: incompatible shapes");
 }
 
-Tensor Tensor::operator-(const Tensor &other) {
+Tensor Tensor::operator-(const Tensor &other) const {
     if (this->dims != other.dims) {
         throw std::invalid_argument("Dimensions must be equal \n");
     }
@@ -240,10 +241,8 @@ Tensor Tensor::operator-(const Tensor &other) {
         vector<size_t> out_shape(dims);
         for (size_t d = 0; d < dims; ++d) out_shape[d] = shape[d];
 
-        vector<double> values;
-
-        for (size_t i = 0; i < shape_product(); ++i)
-            values.push_back(data[i] - other.data[i]);
+        vector<double> values(shape_product());
+        kernels().sub(data, other.data, values.data(), values.size());
 
         return Tensor(out_shape, values);
     }
@@ -257,17 +256,17 @@ Tensor Tensor::operator-(const Tensor &other) {
 
         // (n x m) + (1 x m)
         if (rB == 1 && cA == cB) {
+            values.resize(rA * cA);
             for (size_t i = 0; i < rA; ++i)
-                for (size_t j = 0; j < cA; ++j)
-                    values.push_back(data[i * cA + j] - other.data[j]);
+                kernels().sub(data + i * cA, other.data, values.data() + i * cA, cA);
             return Tensor({rA, cA}, values);
         }
 
         // (1 x m) + (n x m)
         if (rA == 1 && cA == cB) {
+            values.resize(rB * cB);
             for (size_t i = 0; i < rB; ++i)
-                for (size_t j = 0; j < cB; ++j)
-                    values.push_back(data[j] - other.data[i * cB + j]);
+                kernels().sub(data, other.data + i * cB, values.data() + i * cB, cB);
             return Tensor({rB, cB}, values);
         }
     }
@@ -275,7 +274,7 @@ Tensor Tensor::operator-(const Tensor &other) {
     throw std::invalid_argument("operator+: incompatible shapes");
 }
 
-Tensor Tensor::operator*(const Tensor &other) {
+Tensor Tensor::operator*(const Tensor &other) const {
     if (this->dims != other.dims) {
         throw std::invalid_argument("Dimensions must be equal \n");
     }
@@ -289,10 +288,8 @@ Tensor Tensor::operator*(const Tensor &other) {
         vector<size_t> out_shape(dims);
         for (size_t d = 0; d < dims; ++d) out_shape[d] = shape[d];
 
-        vector<double> values;
-
-        for (size_t i = 0; i < shape_product(); ++i)
-            values.push_back(data[i] * other.data[i]);
+        vector<double> values(shape_product());
+        kernels().mul(data, other.data, values.data(), values.size());
 
         return Tensor(out_shape, values);
     }
@@ -306,17 +303,17 @@ Tensor Tensor::operator*(const Tensor &other) {
 
         // (n x m) + (1 x m)
         if (rB == 1 && cA == cB) {
+            values.resize(rA * cA);
             for (size_t i = 0; i < rA; ++i)
-                for (size_t j = 0; j < cA; ++j)
-                    values.emplace_back(data[i * cA + j] * other.data[j]);
+                kernels().mul(data + i * cA, other.data, values.data() + i * cA, cA);
             return Tensor({rA, cA}, values);
         }
 
         // (1 x m) + (n x m)
         if (rA == 1 && cA == cB) {
+            values.resize(rB * cB);
             for (size_t i = 0; i < rB; ++i)
-                for (size_t j = 0; j < cB; ++j)
-                    values.emplace_back(data[j] * other.data[i * cB + j]);
+                kernels().mul(data, other.data + i * cB, values.data() + i * cB, cB);
             return Tensor({rB, cB}, values);
         }
     }
@@ -324,16 +321,15 @@ Tensor Tensor::operator*(const Tensor &other) {
     throw std::invalid_argument("operator+: incompatible shapes");
 }
 
-Tensor Tensor::operator*(double value) {
+Tensor Tensor::operator*(double value) const {
     vector<size_t> shape;
     vector<double> values;
 
     for (size_t i = 0; i < this->dims; i++) {
         shape.emplace_back(this->shape[i]);
     }
-    for (int i = 0; i < this->shape_product(); i++) {
-        values.emplace_back(this->data[i] * value);
-    }
+    values.resize(this->shape_product());
+    kernels().scale(this->data, value, values.data(), values.size());
 
     return Tensor(shape, values);
 }
@@ -497,10 +493,7 @@ Tensor dot(const Tensor &a, const Tensor &b) {
         throw std::invalid_argument("shapes must be equal");
     }
 
-    double result = 0;
-    for (int i = 0; i < a.shape_product(); i++) {
-        result = result + a.data[i] * b.data[i];
-    }
+    double result = dot_kernel(a.data, b.data, a.shape_product());
 
     // Escalar representado como tensor 1D de tamaño 1
     return Tensor({1}, {result});
@@ -523,16 +516,20 @@ Tensor matmul(const Tensor &a, const Tensor &b) {
     vector<size_t> out_shape = {N, M};
     vector<double> values(N * M, 0.0);
 
-    // Multiplicación matricial clásica
-    for (size_t i = 0; i < N; ++i) {
-        for (size_t j = 0; j < M; ++j) {
-            double sum = 0.0;
-            for (size_t k = 0; k < N1; ++k) {
-                sum += a.data[i * N1 + k] * b.data[k * M + j];
-            }
-            values[i * M + j] = sum;
-        }
+    // Formas de vector: (1 x K) * (K x M) y (N x K) * (K x 1). Ambos kernels
+    // suman en k creciente, igual que matmul_kernel
+    if (M == 1) {
+        gemv_ordered_kernel(a.data, b.data, values.data(), N, N1);
+        return Tensor(out_shape, values);
     }
+    if (N == 1) {
+        gevm_kernel(a.data, b.data, values.data(), N1, M);
+        return Tensor(out_shape, values);
+    }
+
+    // Kernel y bloques segun la configuracion afinada (o la heuristica)
+    MatmulConfig config = MatmulTuner::instance().config_for(N, N1, M);
+    matmul_kernel(a.data, b.data, values.data(), N, N1, M, config);
 
     return Tensor(out_shape, values);
 }
@@ -543,14 +540,16 @@ Tensor Tensor::apply(const TensorTransform &transform) const {
     for (size_t i = 0; i < dims; ++i)
         out_shape[i] = shape[i];
 
-    vector<double> values;
-
-    for (size_t i = 0; i < shape_product(); ++i)
-        values.emplace_back(transform.apply(data[i]));
+    vector<double> values(shape_product());
+    transform.apply_n(data, values.data(), values.size());
 
     return Tensor(out_shape, values);
 }
 
+void ReLU::apply_n(const double *in, double *out, size_t n) const {
+    kernels().relu(in, out, n);
+}
+
 
 std::ostream& operator<<(std::ostream& os, const Tensor& t)
 {
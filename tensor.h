@@ -8,14 +8,31 @@
 #include <iostream>
 #include <stdexcept>
 #include <vector>
+#include <string>
 #include <random>
+#include <cmath>
 
 using namespace std;
 
+class Tape;
+class SGD;
+class Adam;
+struct TensorAccess;
+
 class TensorTransform {
 public:
     virtual double apply(double x) const = 0;
 
+    // Derivada f'(x), necesaria para autograd (autograd.h)
+    virtual double derivative(double /*x*/) const {
+        throw std::logic_error("derivative not implemented for this transform");
+    }
+
+    // Aplica la transformacion a n valores; se puede sobrescribir con un kernel
+    virtual void apply_n(const double *in, double *out, size_t n) const {
+        for (size_t i = 0; i < n; ++i) out[i] = apply(in[i]);
+    }
+
     virtual ~TensorTransform() = default;
 };
 
@@ -59,11 +76,11 @@ public:
     // Sobrecarga de operadores
     Tensor operator+(const Tensor &other) const;
 
-    Tensor operator-(const Tensor &other);
+    Tensor operator-(const Tensor &other) const;
 
-    Tensor operator*(const Tensor &other);
+    Tensor operator*(const Tensor &other) const;
 
-    Tensor operator*(double value);
+    Tensor operator*(double value) const;
 
 
     // View y Unsqueeze
@@ -79,6 +96,17 @@ public:
 
     friend Tensor matmul(const Tensor &a, const Tensor &b);
 
+    // Autograd (autograd.h): escriben gradientes y parametros
+    friend class Tape;
+    friend class SGD;
+    friend class Adam;
+
+    // Lectura de los datos desde otros modulos
+    friend struct TensorAccess;
+
+    // Fuera de memoria (out_of_core.h): escribe directamente en los datos
+    friend Tensor load_raw(const std::string &path, const std::vector<size_t> &shape);
+
     // Apply
     Tensor apply(const TensorTransform& transform) const;
 
@@ -86,12 +114,35 @@ public:
     friend std::ostream& operator<<(std::ostream&os, const Tensor &t);
 };
 
+// Acceso de solo lectura a los datos de Tensor para los modulos que no
+// necesitan modificarlo (StaticTensor, SparseTensor, PackedWeight,
+// out_of_core, inference_server, conv)
+struct TensorAccess {
+    static const double *data(const Tensor &t) { return t.data; }
+
+    static size_t dims(const Tensor &t) { return t.dims; }
+
+    static size_t shape(const Tensor &t, size_t d) { return t.shape[d]; }
+};
+
+// Declaraciones fuera de la clase (para llamarlas con ::dot / ::matmul)
+Tensor dot(const Tensor &a, const Tensor &b);
+
+Tensor matmul(const Tensor &a, const Tensor &b);
+
 
 class ReLU : public TensorTransform {
 public:
     double apply(double x) const override {
         return x > 0 ? x : 0;
     }
+
+    double derivative(double x) const override {
+        return x > 0 ? 1 : 0;
+    }
+
+    // Usa el kernel relu de la variante SIMD activa (cpu_dispatch.h)
+    void apply_n(const double *in, double *out, size_t n) const override;
 };
 
 class Sigmoid : public TensorTransform {
@@ -99,6 +150,11 @@ public:
     double apply(double x) const override {
         return 1.0 / (1.0 + std::exp(-x));
     }
+
+    double derivative(double x) const override {
+        double s = apply(x);
+        return s * (1.0 - s);
+    }
 };
 
 
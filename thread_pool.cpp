@@ -0,0 +1,46 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(size_t threads) {
+    stopping = false;
+    if (threads == 0) threads = 1;
+
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+        workers.emplace_back([this]() { worker_loop(); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(m);
+        stopping = true;
+    }
+    cv.notify_all();
+
+    for (auto &w: workers) w.join();
+}
+
+void ThreadPool::submit(function<void()> task) {
+    {
+        lock_guard<mutex> lock(m);
+        tasks.push(std::move(task));
+    }
+    cv.notify_one();
+}
+
+size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+void ThreadPool::worker_loop() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> lock(m);
+            cv.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;  // stopping y sin trabajo
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef TAREA_01_THREAD_POOL_H
+#define TAREA_01_THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Pool de hilos de tamaño fijo con una cola FIFO de tareas
+class ThreadPool {
+private:
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex m;
+    condition_variable cv;
+    bool stopping;
+
+    void worker_loop();
+
+public:
+    explicit ThreadPool(size_t threads);
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Termina las tareas pendientes y une los hilos
+    ~ThreadPool();
+
+    void submit(function<void()> task);
+
+    size_t size() const;
+};
+
+#endif //TAREA_01_THREAD_POOL_H
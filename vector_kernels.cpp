@@ -0,0 +1,37 @@
+#include "vector_kernels.h"
+#include "parallel.h"
+#include "cpu_dispatch.h"
+
+double dot_kernel(const double *a, const double *b, size_t n) {
+    return kernels().dot(a, b, n);
+}
+
+void gemv_ordered_kernel(const double *a, const double *x, double *y, size_t N, size_t K) {
+    // Bloques de 16 filas: dos vectores AVX-512 completos por llamada
+    const size_t block = 16;
+    size_t blocks = (N + block - 1) / block;
+    size_t threads = N * K >= GEMV_PARALLEL_THRESHOLD ? hardware_threads() : 1;
+
+    parallel_for(blocks, threads, [&](size_t b0, size_t b1) {
+        size_t i0 = b0 * block;
+        size_t i1 = b1 * block < N ? b1 * block : N;
+        kernels().gemv(a + i0 * K, x, y + i0, i1 - i0, K);
+    });
+}
+
+void gevm_kernel(const double *x, const double *b, double *y, size_t K, size_t M) {
+    // Bloques de columnas de al menos 64 doubles para no compartir lineas de cache
+    const size_t block = 64;
+    size_t blocks = (M + block - 1) / block;
+    size_t threads = K * M >= GEMV_PARALLEL_THRESHOLD ? hardware_threads() : 1;
+
+    parallel_for(blocks, threads, [&](size_t b0, size_t b1) {
+        size_t j0 = b0 * block;
+        size_t j1 = b1 * block < M ? b1 * block : M;
+
+        const KernelTable &kt = kernels();
+        for (size_t j = j0; j < j1; ++j) y[j] = 0.0;
+        for (size_t k = 0; k < K; ++k)
+            kt.axpy(x[k], b + k * M + j0, y + j0, j1 - j0);
+    });
+}
@@ -0,0 +1,22 @@
+#ifndef TAREA_01_VECTOR_KERNELS_H
+#define TAREA_01_VECTOR_KERNELS_H
+
+#include <cstddef>
+
+// A partir de este numero de elementos de la matriz gemv usa varios hilos
+const size_t GEMV_PARALLEL_THRESHOLD = 1 << 18;
+
+// Producto punto con varios acumuladores independientes (variante SIMD de kernels())
+double dot_kernel(const double *a, const double *b, size_t n);
+
+// y (N) = A (N x K) * x (K), en paralelo por bloques de filas. Cada y[i]
+// suma en k creciente desde 0, como matmul_kernel, por lo que da exactamente
+// su resultado. Es el que usa matmul para (N x K) * (K x 1); cada bloque usa
+// el gemv de kernels(), con una fila por lane del vector SIMD.
+void gemv_ordered_kernel(const double *a, const double *x, double *y, size_t N, size_t K);
+
+// y (M) = x (K) * B (K x M): recorre B por filas una sola vez (y += x[k] * B[k, :]),
+// en paralelo por bloques de columnas
+void gevm_kernel(const double *x, const double *b, double *y, size_t K, size_t M);
+
+#endif //TAREA_01_VECTOR_KERNELS_H